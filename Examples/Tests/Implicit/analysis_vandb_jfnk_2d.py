@@ -15,7 +15,7 @@ import sys
 
 import numpy as np
 import yt
-from scipy.constants import e, epsilon_0
+from scipy.constants import c, e, epsilon_0, m_e
 
 sys.path.insert(1, '../../../../warpx/Regression/Checksum/')
 import checksumAPI
@@ -64,5 +64,35 @@ print(f"tolerance: {tolerance_rel_charge}")
 
 assert( drho_rms < tolerance_rel_charge )
 
+# check the number of GMRES iterations when the curl-curl preconditioner is used
 test_name = os.path.split(os.getcwd())[1]
+if test_name == "ThetaImplicitJFNK_VandB_2d_pc_curl_curl_mlmg":
+    solver_stats = np.loadtxt('diags/reducedfiles/solver_stats.txt', skiprows=1)
+    nonlinear_iterations = solver_stats[-1,7]
+    linear_iterations = solver_stats[-1,8]
+    linear_per_nonlinear = linear_iterations/nonlinear_iterations
+
+    # Without preconditioner, the linear system is dominated by
+    # 1 + (theta*c*dt)^2 curl curl, with condition number kappa below.
+    # The GMRES iterations needed to reduce the residual by gmres.relative_tolerance
+    # are then estimated with the usual Krylov convergence rate.
+    wpe = np.sqrt(n0*e**2/(epsilon_0*m_e))
+    dt = 0.1/wpe
+    dx = 10.*c/wpe/40
+    dz = 10.*c/wpe/40
+    theta = 0.5
+    gmres_rtol = 1.e-8
+    kappa = 1. + (theta*c*dt)**2*(4./dx**2 + 4./dz**2)
+    rate = (np.sqrt(kappa) - 1.)/(np.sqrt(kappa) + 1.)
+    linear_per_nonlinear_no_pc = np.log(gmres_rtol/2.)/np.log(rate)
+
+    print(f"GMRES iterations per Newton iteration: {linear_per_nonlinear}")
+    print(f"estimate without preconditioner: {linear_per_nonlinear_no_pc}")
+
+    assert( linear_per_nonlinear < linear_per_nonlinear_no_pc )
+
+    # The preconditioner only changes the Krylov iterations, not the converged
+    # solution, so both tests are compared to the same benchmark file.
+    test_name = "ThetaImplicitJFNK_VandB_2d"
+
 checksumAPI.evaluate_checksum(test_name, fn)
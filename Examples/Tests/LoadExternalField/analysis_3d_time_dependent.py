@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+
+# This file is part of the WarpX automated test suite. It is used to test the
+# time-dependent external particle fields read from an openPMD series
+# (particles.read_fields_time_dependent = 1).
+#
+# - Generate an openPMD series with three iterations of a uniform electric field,
+#   at unevenly spaced times, and with iteration indices that are not in time order
+# - Run the WarpX simulation in vacuum, so that the only electric field is the external one
+# - Check that the field in each plotfile is the linear interpolation in time
+#   between the two iterations that bracket the time of the gather,
+#   and the field of the first (last) iteration before (after) the series
+
+import glob
+import os
+import re
+
+import numpy as np
+import openpmd_api as io
+
+import yt ; yt.funcs.mylog.setLevel(50)
+
+# Time step and number of steps (see inputs_3d_time_dependent)
+dt = 1.e-10
+max_step = 80
+
+# Iterations of the openPMD series: index, time and amplitude of the field
+iterations = [20, 0, 10]
+times = np.array([1.e-9, 3.e-9, 6.e-9])
+amplitudes = np.array([1.e3, 3.e3, 2.e3])
+# Relative amplitude of each component
+components = {'x': 1., 'y': -2., 'z': 0.5}
+
+# The file covers the simulation domain [0,1]^3 and its guard cells
+n_file = 21
+lo_file = -0.5
+d_file = 0.1
+
+tolerance = 1.e-12
+
+def write_series(filename):
+    series = io.Series(filename, io.Access.create)
+    for index, t, a in zip(iterations, times, amplitudes):
+        it = series.iterations[index]
+        it.time = t
+        it.dt = dt
+        it.time_unit_SI = 1.
+        E = it.meshes['E']
+        E.geometry = io.Geometry.cartesian
+        E.axis_labels = ['x', 'y', 'z']
+        E.grid_spacing = [d_file, d_file, d_file]
+        E.grid_global_offset = [lo_file, lo_file, lo_file]
+        E.grid_unit_SI = 1.
+        E.unit_dimension = {io.Unit_Dimension.M: 1, io.Unit_Dimension.L: 1,
+                            io.Unit_Dimension.I: -1, io.Unit_Dimension.T: -3}
+        for comp, factor in components.items():
+            data = np.full((n_file, n_file, n_file), factor*a)
+            E_comp = E[comp]
+            E_comp.position = [0., 0., 0.]
+            E_comp.reset_dataset(io.Dataset(data.dtype, data.shape))
+            E_comp.store_chunk(data)
+            series.flush()
+        it.close()
+    series.close()
+
+def do_analysis(fname):
+    step = int(re.findall(r'(\d+)/?$', fname)[0])
+    ds = yt.load(fname)
+    data = ds.covering_grid(level=0, left_edge=ds.domain_left_edge, dims=ds.domain_dimensions)
+
+    # The fields in the plotfile are those gathered by the particles during the
+    # last step, i.e. the external field at the beginning of that step
+    t_gather = (step-1)*dt
+    # np.interp also holds the field constant outside of the time range of the series
+    a = np.interp(t_gather, times, amplitudes)
+
+    for comp, factor in components.items():
+        E = data['boxlib', 'E'+comp].v
+        error = np.max(np.abs(E - factor*a))/np.abs(factor*a)
+        print(f'{fname}: E{comp} relative error = {error}')
+        assert(error < tolerance)
+
+def launch_analysis(executable):
+    os.system("./" + executable + " inputs_3d_time_dependent diag1.file_prefix=diags/plotfiles/plt")
+    plotfiles = sorted(glob.glob("diags/plotfiles/plt??????"))
+    # The series must be used before, between and after its iterations
+    assert(len(plotfiles) == max_step//5 + 1)
+    for fname in plotfiles[1:]:
+        do_analysis(fname)
+
+def main() :
+    write_series("external_fields.h5")
+    executables = glob.glob("*.ex")
+    if len(executables) == 1 :
+        launch_analysis(executables[0])
+    else :
+        assert(False)
+    print('Passed')
+
+if __name__ == "__main__":
+    main()
@@ -105,4 +105,9 @@ assert (np.all(np.abs((xx - xxa)/xx) < 1.e-15)), 'Reflecting particle position n
 assert (np.all(np.abs((zz - zza)/zz) < 1.e-15)), 'Periodic particle position not correct'
 
 test_name = os.path.split(os.getcwd())[1]
+# Redistributing all species together (on more MPI ranks) must give the same
+# particles as redistributing each species separately, so both tests are
+# compared to the same benchmark file.
+if test_name == "particle_boundaries_3d_batched_redistribute":
+    test_name = "particle_boundaries_3d"
 checksumAPI.evaluate_checksum(test_name, filename)
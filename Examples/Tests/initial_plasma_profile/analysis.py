@@ -20,5 +20,9 @@ import checksumAPI
 fn = sys.argv[1]
 
 test_name = os.path.split(os.getcwd())[1]
+# The tabulated parser profile must reproduce the predefined profile,
+# so both tests are compared to the same benchmark file.
+if test_name == "parabolic_channel_initialization_2d_density_table":
+    test_name = "parabolic_channel_initialization_2d_single_precision"
 
 checksumAPI.evaluate_checksum(test_name, fn, rtol=1e-4, do_particles=False)
@@ -103,4 +103,11 @@ except yt.utilities.exceptions.YTFieldNotFound:
     pass # The backtransformed diagnostic version of the test does not have orig_z
 
 test_name = os.path.split(os.getcwd())[1]
+# The fused push of the electrons and ions (with a zero constant external field,
+# which goes through the external field path of the fused push without changing
+# the result) must reproduce the per-species push, so both tests are compared
+# to the same benchmark file.
+if test_name == "ionization_lab_fused_push":
+    test_name = "ionization_lab"
+
 checksumAPI.evaluate_checksum(test_name, filename)
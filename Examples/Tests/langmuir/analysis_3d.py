@@ -191,6 +191,10 @@ if div_cleaning:
     assert(error_rel < tolerance)
 
 test_name = os.path.split(os.getcwd())[1]
+# The temporally-blocked FDTD push must give the same fields as the standard
+# push, so both tests are compared to the same benchmark file.
+if test_name == "Langmuir_multi_fdtd_temporal_blocking":
+    test_name = "Langmuir_multi"
 
 if re.search( 'single_precision', fn ):
     checksumAPI.evaluate_checksum(test_name, fn, rtol=1.e-3)
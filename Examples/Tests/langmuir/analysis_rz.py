@@ -155,4 +155,9 @@ random_fraction = 0.66
 post_processing_utils.check_random_filter(fn, random_filter_fn, random_fraction,
                                           dim, species_name)
 
+# The sorted charge deposition (of both species together, with two azimuthal modes)
+# must reproduce the standard one, so both tests are compared to the same benchmark file.
+if test_name == "Langmuir_multi_rz_psatd_multiJ_sorted_deposition":
+    test_name = "Langmuir_multi_rz_psatd_multiJ"
+
 checksumAPI.evaluate_checksum(test_name, fn)
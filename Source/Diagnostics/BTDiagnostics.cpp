@@ -262,6 +262,10 @@ BTDiagnostics::ReadParameters ()
         "For back-transformed diagnostics, user should specify either dz_snapshots_lab or dt_snapshots_lab");
 
     utils::parser::queryWithParser(pp_diag_name, "buffer_size", m_buffer_size);
+    utils::parser::queryWithParser(pp_diag_name, "num_io_ranks", m_num_io_ranks);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_num_io_ranks >= 0 && m_num_io_ranks <= amrex::ParallelDescriptor::NProcs(),
+        m_diag_name + ".num_io_ranks must be between 0 and the number of MPI ranks");
 #ifdef WARPX_DIM_RZ
     const amrex::Vector< std::string > BTD_varnames_supported = {"Er", "Et", "Ez",
                                                            "Br", "Bt", "Bz",
@@ -905,7 +909,7 @@ BTDiagnostics::DefineFieldBufferMultiFab (const int i_buffer, const int lev)
     m_buffer_box[i_buffer].setBig( m_moving_window_dir, hi_k_lab );
     const amrex::BoxArray buffer_ba( m_buffer_box[i_buffer] );
     // Generate a new distribution map for the back-transformed buffer multifab
-    const amrex::DistributionMapping buffer_dmap(buffer_ba);
+    const amrex::DistributionMapping buffer_dmap = BufferDistributionMapping(i_buffer, buffer_ba);
     // Number of guard cells for the output buffer is zero.
     // Unlike FullDiagnostics, "m_format == sensei" option is not included here.
     const int ngrow = 0;
@@ -977,6 +981,19 @@ BTDiagnostics::DefineSnapshotGeometry (const int i_buffer, const int lev)
     m_snapshot_geometry_defined[i_buffer] = 1;
 }
 
+amrex::DistributionMapping
+BTDiagnostics::BufferDistributionMapping (const int i_buffer, const amrex::BoxArray& buffer_ba) const
+{
+    if (m_num_io_ranks == 0) { return amrex::DistributionMapping(buffer_ba); }
+
+    // Spread the snapshots over the last m_num_io_ranks ranks, so that the
+    // lab-frame buffers do not all accumulate on the same rank
+    const int nprocs = amrex::ParallelDescriptor::NProcs();
+    const int owner = nprocs - m_num_io_ranks + i_buffer % m_num_io_ranks;
+    amrex::Vector<int> pmap(buffer_ba.size(), owner);
+    return amrex::DistributionMapping(std::move(pmap));
+}
+
 bool
 BTDiagnostics::GetZSliceInDomainFlag (const int i_buffer, const int lev)
 {
@@ -1101,6 +1118,13 @@ BTDiagnostics::Flush (int i_buffer, bool force_flush)
     // Reset the buffer counter to zero after flushing out data stored in the buffer.
     ResetBufferCounter(i_buffer);
     m_field_buffer_multifab_defined[i_buffer] = 0;
+    // Once a snapshot is full, no more slices are back-transformed into its
+    // buffer: release the buffer memory instead of keeping it until the end of the run
+    if (m_snapshot_full[i_buffer] == 1) {
+        for (int lev = 0; lev < nlev_output; ++lev) {
+            m_mf_output[i_buffer][lev].clear();
+        }
+    }
     IncrementBufferFlushCounter(i_buffer);
     NullifyFirstFlush(i_buffer);
     // if particles are selected for output then update and reset counters
@@ -1470,7 +1494,7 @@ BTDiagnostics::PrepareParticleDataForOutput()
                         }
                         const amrex::Box particle_buffer_box = m_buffer_box[i_buffer];
                         const amrex::BoxArray buffer_ba( particle_buffer_box );
-                        const amrex::DistributionMapping buffer_dmap(buffer_ba);
+                        const amrex::DistributionMapping buffer_dmap = BufferDistributionMapping(i_buffer, buffer_ba);
                         m_particles_buffer[i_buffer][i]->SetParticleBoxArray(lev, buffer_ba);
                         m_particles_buffer[i_buffer][i]->SetParticleDistributionMap(lev, buffer_dmap);
                         m_particles_buffer[i_buffer][i]->SetParticleGeometry(lev, m_geom_snapshot[i_buffer][lev]);
@@ -17,6 +17,7 @@
 #include <AMReX_MultiFab.H>
 
 #include <memory>
+#include <string>
 
 RhoFunctor::RhoFunctor (const int lev,
                         const amrex::IntVect crse_ratio,
@@ -33,6 +34,23 @@ RhoFunctor::RhoFunctor (const int lev,
 
 void
 RhoFunctor::operator() ( amrex::MultiFab& mf_dst, const int dcomp, const int /*i_buffer*/ ) const
+{
+    auto& warpx = WarpX::GetInstance();
+
+    // The charge density is shared with the other diagnostics computed at the same time
+    const std::string key = "rho_lev" + std::to_string(m_lev)
+        + "_species" + std::to_string(m_species_index)
+        + "_filter" + std::to_string(static_cast<int>(m_apply_rz_psatd_filter));
+
+    const std::shared_ptr<const amrex::MultiFab> rho = warpx.GetDerivedFieldCache().Get(key,
+        [&] () { return ComputeRho(); });
+
+    InterpolateMFForDiag(mf_dst, *rho, dcomp, warpx.DistributionMap(m_lev),
+                         m_convertRZmodes2cartesian);
+}
+
+std::unique_ptr<amrex::MultiFab>
+RhoFunctor::ComputeRho () const
 {
     auto& warpx = WarpX::GetInstance();
     std::unique_ptr<amrex::MultiFab> rho;
@@ -72,10 +90,7 @@ RhoFunctor::operator() ( amrex::MultiFab& mf_dst, const int dcomp, const int /*i
             solver.BackwardTransform(m_lev, *rho, Idx.rho_new);
         }
     }
-#else
-    amrex::ignore_unused(m_apply_rz_psatd_filter);
 #endif
 
-    InterpolateMFForDiag(mf_dst, *rho, dcomp, warpx.DistributionMap(m_lev),
-                         m_convertRZmodes2cartesian);
+    return rho;
 }
@@ -0,0 +1,194 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "CheckpointDelta.H"
+
+#include "Utils/TextMsg.H"
+
+#include <AMReX.H>
+#include <AMReX_BoxList.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Utility.H>
+#include <AMReX_Vector.H>
+#include <AMReX_VisMF.H>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace amrex;
+
+namespace
+{
+    /** Hash of one value of a box, mixed with its position in the box
+     *  (splitmix64 finalizer), so that the sum over the box is order-sensitive */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    unsigned long long HashValue (amrex::Real value, unsigned long long index) noexcept
+    {
+        unsigned long long bits = 0;
+        std::memcpy(&bits, &value, sizeof(amrex::Real));
+        unsigned long long z = bits ^ (index * 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    /** Indices (in the full BoxArray) of the boxes written in a delta checkpoint */
+    std::vector<int> ReadDeltaBoxes (const std::string& mf_name)
+    {
+        Vector<char> fileCharPtr;
+        ParallelDescriptor::ReadAndBcastFile(mf_name + CheckpointDelta::boxes_file_suffix, fileCharPtr);
+        const std::string fileCharPtrString(fileCharPtr.dataPtr());
+        std::istringstream is(fileCharPtrString, std::istringstream::in);
+        is.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+
+        int nboxes = 0;
+        is >> nboxes;
+        std::vector<int> indices(nboxes);
+        for (auto& i : indices) { is >> i; }
+        return indices;
+    }
+
+    /** MultiFab defined on a subset of the boxes of mf, owned by the same ranks */
+    MultiFab MakeSubsetMultiFab (const MultiFab& mf, const std::vector<int>& indices)
+    {
+        BoxList bl(mf.boxArray().ixType());
+        Vector<int> pmap;
+        for (const int i : indices) {
+            bl.push_back(mf.boxArray()[i]);
+            pmap.push_back(mf.DistributionMap()[i]);
+        }
+        return MultiFab{BoxArray(std::move(bl)), DistributionMapping(std::move(pmap)),
+                        mf.nComp(), mf.nGrowVect()};
+    }
+}
+
+CheckpointDelta::BoxHashes
+CheckpointDelta::ComputeBoxHashes (const amrex::MultiFab& mf)
+{
+    BoxHashes hashes;
+    const int ncomp = mf.nComp();
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.fabbox();
+        auto const& arr = mf.const_array(mfi);
+        const Dim3 lo = lbound(bx);
+        const IntVect len = bx.length();
+        const auto nx = static_cast<unsigned long long>(len[0]);
+        const auto ny = static_cast<unsigned long long>(AMREX_D_PICK(1, len[1], len[1]));
+        const auto nz = static_cast<unsigned long long>(AMREX_D_PICK(1, 1, len[2]));
+
+        ReduceOps<ReduceOpSum> reduce_op;
+        ReduceData<unsigned long long> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+        reduce_op.eval(bx, ncomp, reduce_data,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) -> ReduceTuple
+            {
+                const auto index = ((static_cast<unsigned long long>(n)*nz
+                                     + static_cast<unsigned long long>(k-lo.z))*ny
+                                    + static_cast<unsigned long long>(j-lo.y))*nx
+                                   + static_cast<unsigned long long>(i-lo.x);
+                return {HashValue(arr(i,j,k,n), index)};
+            });
+        hashes[mfi.index()] = static_cast<std::uint64_t>(amrex::get<0>(reduce_data.value(reduce_op)));
+    }
+    return hashes;
+}
+
+void
+CheckpointDelta::WriteBase (const amrex::MultiFab& mf, const std::string& mf_name, BaseState& base_state)
+{
+    VisMF::AsyncWrite(mf, mf_name);
+    base_state.ba = mf.boxArray();
+    base_state.dm = mf.DistributionMap();
+    base_state.hashes = ComputeBoxHashes(mf);
+}
+
+void
+CheckpointDelta::WriteDelta (const amrex::MultiFab& mf, const std::string& mf_name, const BaseState& base_state)
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        base_state.ba == mf.boxArray() && base_state.dm == mf.DistributionMap(),
+        "CheckpointDelta::WriteDelta: the grids changed since the base checkpoint");
+
+    // Flag the boxes whose content changed since the base checkpoint, on any rank
+    std::vector<int> changed(mf.size(), 0);
+    for (auto const& [i, hash] : ComputeBoxHashes(mf)) {
+        auto const it = base_state.hashes.find(i);
+        if (it == base_state.hashes.end() || it->second != hash) { changed[i] = 1; }
+    }
+    ParallelDescriptor::ReduceIntMax(changed.data(), static_cast<int>(changed.size()));
+
+    std::vector<int> indices;
+    for (int i = 0; i < static_cast<int>(changed.size()); ++i) {
+        if (changed[i]) { indices.push_back(i); }
+    }
+
+    if (ParallelDescriptor::IOProcessor()) {
+        const std::string boxes_file_name = mf_name + boxes_file_suffix;
+        std::ofstream boxes_file(boxes_file_name.c_str(), std::ios::out|std::ios::trunc);
+        if (!boxes_file.good()) { amrex::FileOpenFailed(boxes_file_name); }
+        boxes_file << indices.size() << "\n";
+        for (const int i : indices) { boxes_file << i << "\n"; }
+        boxes_file.close();
+    }
+
+    if (indices.empty()) { return; }
+
+    MultiFab delta = MakeSubsetMultiFab(mf, indices);
+    for (MFIter mfi(delta); mfi.isValid(); ++mfi) {
+        delta[mfi].copy<RunOn::Device>(mf[indices[mfi.index()]]);
+    }
+    VisMF::AsyncWrite(delta, mf_name);
+}
+
+void
+CheckpointDelta::Read (amrex::MultiFab& mf, const std::string& mf_name, const std::string& base_mf_name)
+{
+    // Fields that were not part of the base checkpoint are written completely
+    if (base_mf_name.empty() || !amrex::FileExists(mf_name + boxes_file_suffix)) {
+        VisMF::Read(mf, mf_name);
+        return;
+    }
+
+    VisMF::Read(mf, base_mf_name);
+
+    const std::vector<int> indices = ReadDeltaBoxes(mf_name);
+    if (indices.empty()) { return; }
+
+    MultiFab delta = MakeSubsetMultiFab(mf, indices);
+    VisMF::Read(delta, mf_name);
+    for (MFIter mfi(delta); mfi.isValid(); ++mfi) {
+        mf[indices[mfi.index()]].copy<RunOn::Device>(delta[mfi]);
+    }
+}
+
+std::string
+CheckpointDelta::GetBaseCheckpoint (const std::string& chkfile)
+{
+    std::string dir = chkfile;
+    while (!dir.empty() && dir.back() == '/') { dir.pop_back(); }
+
+    const std::string file_name = dir + "/" + base_file_name;
+    if (!amrex::FileExists(file_name)) { return std::string{}; }
+
+    Vector<char> fileCharPtr;
+    ParallelDescriptor::ReadAndBcastFile(file_name, fileCharPtr);
+    const std::string fileCharPtrString(fileCharPtr.dataPtr());
+    std::istringstream is(fileCharPtrString, std::istringstream::in);
+    is.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+
+    std::string base_name;
+    is >> base_name;
+
+    // The base checkpoint is in the same directory as the delta checkpoint
+    const auto pos = dir.find_last_of('/');
+    return (pos == std::string::npos) ? base_name : dir.substr(0, pos+1) + base_name;
+}
@@ -1,5 +1,7 @@
 #include "FlushFormatCheckpoint.H"
 
+#include "CheckpointDelta.H"
+
 #include "BoundaryConditions/PML.H"
 #if (defined WARPX_DIM_RZ) && (defined WARPX_USE_FFT)
 #   include "BoundaryConditions/PML_RZ.H"
@@ -7,11 +9,15 @@
 #include "Diagnostics/ParticleDiag/ParticleDiag.H"
 #include "FieldSolver/Fields.H"
 #include "Particles/WarpXParticleContainer.H"
+#include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
 
+#include <AMReX_AsyncOut.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParticleIO.H>
 #include <AMReX_PlotFileUtil.H>
 #include <AMReX_Print.H>
@@ -19,12 +25,16 @@
 #include <AMReX_Utility.H>
 #include <AMReX_VisMF.H>
 
+#include <fstream>
+#include <string>
+
 using namespace amrex;
 using namespace warpx::fields;
 
 namespace
 {
     const std::string default_level_prefix {"Level_"};
+    const std::string checkpoint_complete_marker {"CheckpointComplete"};
 }
 
 void
@@ -47,6 +57,10 @@ FlushFormatCheckpoint::WriteToFile (
 
     auto & warpx = WarpX::GetInstance();
 
+    // With asynchronous output, at most one checkpoint is being written in
+    // the background while the next one is staged: wait for the previous one.
+    WaitForPendingCheckpoint();
+
     const VisMF::Header::Version current_version = VisMF::GetHeaderVersion();
     VisMF::SetHeaderVersion(amrex::VisMF::Header::NoFabHeader_v1);
 
@@ -55,95 +69,116 @@ FlushFormatCheckpoint::WriteToFile (
     amrex::Print() << Utils::TextMsg::Info(
         "Writing checkpoint " + checkpointname);
 
+    // Delta checkpoints are only possible as long as the grids are the same as
+    // at the time of the base checkpoint
+    bool is_delta = !m_base_checkpoint.empty() &&
+        m_checkpoints_since_base + 1 < m_full_checkpoint_period &&
+        static_cast<int>(m_base_grids.size()) == nlev;
+    for (int lev = 0; is_delta && lev < nlev; ++lev) {
+        is_delta = (m_base_grids[lev] == warpx.boxArray(lev)) &&
+            (m_base_dmaps[lev] == warpx.DistributionMap(lev));
+    }
+
     // const int nlevels = finestLevel()+1;
     amrex::PreBuildDirectorHierarchy(checkpointname, default_level_prefix, nlev, true);
 
+    if (is_delta) {
+        ++m_checkpoints_since_base;
+        if (ParallelDescriptor::IOProcessor()) {
+            const std::string base_file_name = checkpointname + "/" + CheckpointDelta::base_file_name;
+            std::ofstream base_file(base_file_name.c_str(), std::ios::out|std::ios::trunc);
+            if (!base_file.good()) { amrex::FileOpenFailed(base_file_name); }
+            // The base checkpoint is in the same directory as this checkpoint
+            base_file << m_base_checkpoint.substr(m_base_checkpoint.find_last_of('/')+1) << "\n";
+            base_file.close();
+        }
+    } else {
+        m_checkpoints_since_base = 0;
+        m_base_checkpoint = checkpointname;
+        m_base_grids.resize(nlev);
+        m_base_dmaps.resize(nlev);
+        for (int lev = 0; lev < nlev; ++lev) {
+            m_base_grids[lev] = warpx.boxArray(lev);
+            m_base_dmaps[lev] = warpx.DistributionMap(lev);
+        }
+        m_base_states.clear();
+    }
+
+    // Write a field, either completely (base checkpoint) or only the boxes
+    // that changed since the base checkpoint (delta checkpoint)
+    const auto write_field = [&] (const amrex::MultiFab& mf, int lev, const std::string& name)
+    {
+        const std::string mf_name = amrex::MultiFabFileFullPrefix(
+            lev, checkpointname, default_level_prefix, name);
+        const std::string key = amrex::MultiFabFileFullPrefix(lev, "", default_level_prefix, name);
+        if (is_delta && m_base_states.count(key) > 0) {
+            CheckpointDelta::WriteDelta(mf, mf_name, m_base_states.at(key));
+        } else if (is_delta) {
+            // This field was not part of the base checkpoint
+            VisMF::AsyncWrite(mf, mf_name);
+        } else if (m_full_checkpoint_period > 1) {
+            CheckpointDelta::WriteBase(mf, mf_name, m_base_states[key]);
+        } else {
+            VisMF::AsyncWrite(mf, mf_name);
+        }
+    };
+
     WriteWarpXHeader(checkpointname, geom);
 
     WriteJobInfo(checkpointname);
 
     for (int lev = 0; lev < nlev; ++lev)
     {
-        VisMF::Write(warpx.getField(FieldType::Efield_fp, lev, 0),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_fp"));
-        VisMF::Write(warpx.getField(FieldType::Efield_fp, lev, 1),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_fp"));
-        VisMF::Write(warpx.getField(FieldType::Efield_fp, lev, 2),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_fp"));
-        VisMF::Write(warpx.getField(FieldType::Bfield_fp, lev, 0),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_fp"));
-        VisMF::Write(warpx.getField(FieldType::Bfield_fp, lev, 1),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_fp"));
-        VisMF::Write(warpx.getField(FieldType::Bfield_fp, lev, 2),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_fp"));
+        write_field(warpx.getField(FieldType::Efield_fp, lev, 0), lev, "Ex_fp");
+        write_field(warpx.getField(FieldType::Efield_fp, lev, 1), lev, "Ey_fp");
+        write_field(warpx.getField(FieldType::Efield_fp, lev, 2), lev, "Ez_fp");
+        write_field(warpx.getField(FieldType::Bfield_fp, lev, 0), lev, "Bx_fp");
+        write_field(warpx.getField(FieldType::Bfield_fp, lev, 1), lev, "By_fp");
+        write_field(warpx.getField(FieldType::Bfield_fp, lev, 2), lev, "Bz_fp");
 
         if (WarpX::fft_do_time_averaging)
         {
-            VisMF::Write(warpx.getField(FieldType::Efield_avg_fp, lev, 0),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_avg_fp"));
-            VisMF::Write(warpx.getField(FieldType::Efield_avg_fp, lev, 1),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_avg_fp"));
-            VisMF::Write(warpx.getField(FieldType::Efield_avg_fp, lev, 2),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_avg_fp"));
-
-            VisMF::Write(warpx.getField(FieldType::Bfield_avg_fp, lev, 0),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_avg_fp"));
-            VisMF::Write(warpx.getField(FieldType::Bfield_avg_fp, lev, 1),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_avg_fp"));
-            VisMF::Write(warpx.getField(FieldType::Bfield_avg_fp, lev, 2),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_avg_fp"));
+            write_field(warpx.getField(FieldType::Efield_avg_fp, lev, 0), lev, "Ex_avg_fp");
+            write_field(warpx.getField(FieldType::Efield_avg_fp, lev, 1), lev, "Ey_avg_fp");
+            write_field(warpx.getField(FieldType::Efield_avg_fp, lev, 2), lev, "Ez_avg_fp");
+
+            write_field(warpx.getField(FieldType::Bfield_avg_fp, lev, 0), lev, "Bx_avg_fp");
+            write_field(warpx.getField(FieldType::Bfield_avg_fp, lev, 1), lev, "By_avg_fp");
+            write_field(warpx.getField(FieldType::Bfield_avg_fp, lev, 2), lev, "Bz_avg_fp");
         }
 
         if (warpx.getis_synchronized()) {
             // Need to save j if synchronized because after restart we need j to evolve E by dt/2.
-            VisMF::Write(warpx.getField(FieldType::current_fp, lev, 0),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jx_fp"));
-            VisMF::Write(warpx.getField(FieldType::current_fp, lev, 1),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jy_fp"));
-            VisMF::Write(warpx.getField(FieldType::current_fp, lev, 2),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jz_fp"));
+            write_field(warpx.getField(FieldType::current_fp, lev, 0), lev, "jx_fp");
+            write_field(warpx.getField(FieldType::current_fp, lev, 1), lev, "jy_fp");
+            write_field(warpx.getField(FieldType::current_fp, lev, 2), lev, "jz_fp");
         }
 
         if (lev > 0)
         {
-            VisMF::Write(warpx.getField(FieldType::Efield_cp, lev, 0),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_cp"));
-            VisMF::Write(warpx.getField(FieldType::Efield_cp, lev, 1),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_cp"));
-            VisMF::Write(warpx.getField(FieldType::Efield_cp, lev, 2),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_cp"));
-            VisMF::Write(warpx.getField(FieldType::Bfield_cp, lev, 0),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_cp"));
-            VisMF::Write(warpx.getField(FieldType::Bfield_cp, lev, 1),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_cp"));
-            VisMF::Write(warpx.getField(FieldType::Bfield_cp, lev, 2),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_cp"));
+            write_field(warpx.getField(FieldType::Efield_cp, lev, 0), lev, "Ex_cp");
+            write_field(warpx.getField(FieldType::Efield_cp, lev, 1), lev, "Ey_cp");
+            write_field(warpx.getField(FieldType::Efield_cp, lev, 2), lev, "Ez_cp");
+            write_field(warpx.getField(FieldType::Bfield_cp, lev, 0), lev, "Bx_cp");
+            write_field(warpx.getField(FieldType::Bfield_cp, lev, 1), lev, "By_cp");
+            write_field(warpx.getField(FieldType::Bfield_cp, lev, 2), lev, "Bz_cp");
 
             if (WarpX::fft_do_time_averaging)
             {
-                VisMF::Write(warpx.getField(FieldType::Efield_avg_cp, lev, 0),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_avg_cp"));
-                VisMF::Write(warpx.getField(FieldType::Efield_avg_cp, lev, 1),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_avg_cp"));
-                VisMF::Write(warpx.getField(FieldType::Efield_avg_cp, lev, 2),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_avg_cp"));
-
-                VisMF::Write(warpx.getField(FieldType::Bfield_avg_cp, lev, 0),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_avg_cp"));
-                VisMF::Write(warpx.getField(FieldType::Bfield_avg_cp, lev, 1),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_avg_cp"));
-                VisMF::Write(warpx.getField(FieldType::Bfield_avg_cp, lev, 2),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_avg_cp"));
+                write_field(warpx.getField(FieldType::Efield_avg_cp, lev, 0), lev, "Ex_avg_cp");
+                write_field(warpx.getField(FieldType::Efield_avg_cp, lev, 1), lev, "Ey_avg_cp");
+                write_field(warpx.getField(FieldType::Efield_avg_cp, lev, 2), lev, "Ez_avg_cp");
+
+                write_field(warpx.getField(FieldType::Bfield_avg_cp, lev, 0), lev, "Bx_avg_cp");
+                write_field(warpx.getField(FieldType::Bfield_avg_cp, lev, 1), lev, "By_avg_cp");
+                write_field(warpx.getField(FieldType::Bfield_avg_cp, lev, 2), lev, "Bz_avg_cp");
             }
 
             if (warpx.getis_synchronized()) {
                 // Need to save j if synchronized because after restart we need j to evolve E by dt/2.
-                VisMF::Write(warpx.getField(FieldType::current_cp, lev, 0),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jx_cp"));
-                VisMF::Write(warpx.getField(FieldType::current_cp, lev, 1),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jy_cp"));
-                VisMF::Write(warpx.getField(FieldType::current_cp, lev, 2),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jz_cp"));
+                write_field(warpx.getField(FieldType::current_cp, lev, 0), lev, "jx_cp");
+                write_field(warpx.getField(FieldType::current_cp, lev, 1), lev, "jy_cp");
+                write_field(warpx.getField(FieldType::current_cp, lev, 2), lev, "jz_cp");
             }
         }
 
@@ -167,6 +202,53 @@ FlushFormatCheckpoint::WriteToFile (
 
     VisMF::SetHeaderVersion(current_version);
 
+    m_pending_checkpoint = checkpointname;
+    if (!amrex::AsyncOut::UseAsyncOut()) {
+        WaitForPendingCheckpoint();
+    }
+}
+
+FlushFormatCheckpoint::FlushFormatCheckpoint (const std::string& diag_name)
+{
+    const amrex::ParmParse pp_diag_name(diag_name);
+    utils::parser::queryWithParser(pp_diag_name, "full_checkpoint_period", m_full_checkpoint_period);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_full_checkpoint_period >= 1,
+        diag_name + ".full_checkpoint_period must be at least 1");
+}
+
+FlushFormatCheckpoint::~FlushFormatCheckpoint ()
+{
+    WaitForPendingCheckpoint();
+}
+
+void
+FlushFormatCheckpoint::WaitForPendingCheckpoint () const
+{
+    if (m_pending_checkpoint.empty()) { return; }
+
+    WARPX_PROFILE("FlushFormatCheckpoint::WaitForPendingCheckpoint()");
+
+    // Wait for the local background writes, then for all the other ranks
+    if (amrex::AsyncOut::UseAsyncOut()) {
+        amrex::AsyncOut::Finish();
+    }
+    ParallelDescriptor::Barrier();
+
+    // The marker file signals that the checkpoint is complete on disk,
+    // so that older checkpoints can be safely removed (except the base
+    // checkpoints named in the DeltaBase file of the delta checkpoints that are kept)
+    if (ParallelDescriptor::IOProcessor()) {
+        const std::string marker_name = m_pending_checkpoint + "/" + checkpoint_complete_marker;
+        std::ofstream marker_file(marker_name.c_str(), std::ios::out|std::ios::trunc);
+        if (!marker_file.good()) { amrex::FileOpenFailed(marker_name); }
+        marker_file.close();
+    }
+
+    if (amrex::AsyncOut::UseAsyncOut()) {
+        amrex::Print() << Utils::TextMsg::Info(
+            "Checkpoint " + m_pending_checkpoint + " is complete");
+    }
+    m_pending_checkpoint.clear();
 }
 
 void
@@ -72,43 +72,60 @@ FlushFormatOpenPMD::FlushFormatOpenPMD (const std::string& diag_name)
         }
     }
 
+    // read all the parameters <prefix>.* into a map
+    auto const get_parameters = [] (std::string const& prefix)
+    {
+        const ParmParse pp;
+        auto entr = amrex::ParmParse::getEntries(prefix);
+
+        std::map< std::string, std::string > parameters;
+        auto const prefix_len = prefix.size() + 1;
+        for (std::string k : entr) {
+            std::string v;
+            pp.get(k.c_str(), v);
+            k.erase(0, prefix_len);
+            parameters.insert({k, v});
+        }
+        return parameters;
+    };
+
     // ADIOS2 operator type & parameters
     std::string operator_type;
     pp_diag_name.query("adios2_operator.type", operator_type);
-    std::string const prefix = diag_name + ".adios2_operator.parameters";
-    const ParmParse pp;
-    auto entr = amrex::ParmParse::getEntries(prefix);
-
-    std::map< std::string, std::string > operator_parameters;
-    auto const prefix_len = prefix.size() + 1;
-    for (std::string k : entr) {
-        std::string v;
-        pp.get(k.c_str(), v);
-        k.erase(0, prefix_len);
-        operator_parameters.insert({k, v});
+    auto const operator_parameters = get_parameters(diag_name + ".adios2_operator.parameters");
+
+    // ADIOS2 operator type & parameters for specific fields or species:
+    //   <diag_name>.<field_or_species_name>.adios2_operator.type
+    std::map< std::string, std::string > dataset_operator_types;
+    std::map< std::string, std::map< std::string, std::string > > dataset_operator_parameters;
+    std::string const operator_suffix = ".adios2_operator.type";
+    for (auto const& k : amrex::ParmParse::getEntries(diag_name)) {
+        if (k.size() <= diag_name.size() + 1 + operator_suffix.size() ||
+            k.compare(0, diag_name.size() + 1, diag_name + ".") != 0 ||
+            k.compare(k.size() - operator_suffix.size(), operator_suffix.size(), operator_suffix) != 0) {
+            continue;
+        }
+        std::string const name = k.substr(diag_name.size() + 1,
+            k.size() - diag_name.size() - 1 - operator_suffix.size());
+        if (name.find('.') != std::string::npos) { continue; }
+        std::string type;
+        pp_diag_name.get((name + operator_suffix).c_str(), type);
+        dataset_operator_types.insert({name, type});
+        dataset_operator_parameters.insert(
+            {name, get_parameters(diag_name + "." + name + ".adios2_operator.parameters")});
     }
 
     // ADIOS2 engine type & parameters
     std::string engine_type;
     pp_diag_name.query("adios2_engine.type", engine_type);
-    std::string const engine_prefix = diag_name + ".adios2_engine.parameters";
-    const ParmParse ppe;
-    auto eng_entr = amrex::ParmParse::getEntries(engine_prefix);
-
-    std::map< std::string, std::string > engine_parameters;
-    auto const prefixlen = engine_prefix.size() + 1;
-    for (std::string k : eng_entr) {
-        std::string v;
-        ppe.get(k.c_str(), v);
-        k.erase(0, prefixlen);
-        engine_parameters.insert({k, v});
-    }
+    auto const engine_parameters = get_parameters(diag_name + ".adios2_engine.parameters");
 
     auto & warpx = WarpX::GetInstance();
     m_OpenPMDPlotWriter = std::make_unique<WarpXOpenPMDPlot>(
         encoding, openpmd_backend,
         operator_type, operator_parameters,
         engine_type, engine_parameters,
+        dataset_operator_types, dataset_operator_parameters,
         warpx.getPMLdirections(),
         warpx.GetAuthors()
     );
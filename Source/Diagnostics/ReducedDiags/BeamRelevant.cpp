@@ -6,6 +6,7 @@
  */
 #include "BeamRelevant.H"
 
+#include "Diagnostics/ReducedDiags/ParticleMoments.H"
 #include "Diagnostics/ReducedDiags/ReducedDiags.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/WarpXParticleContainer.H"
@@ -38,6 +39,7 @@ BeamRelevant::BeamRelevant (const std::string& rd_name)
     // read beam name
     const ParmParse pp_rd_name(rd_name);
     pp_rd_name.get("species",m_beam_name);
+    ParticleMoments::Register(m_beam_name, m_intervals);
 
     // resize data array
 #if (defined WARPX_DIM_3D || defined WARPX_DIM_RZ)
@@ -172,9 +174,6 @@ void BeamRelevant::ComputeDiags (int step)
     // get species names (std::vector<std::string>)
     auto const species_names = mypc.GetSpeciesNames();
 
-    // inverse of speed of light squared
-    Real constexpr inv_c2 = 1.0_rt / (PhysConst::c * PhysConst::c);
-
     // loop over species
     for (int i_s = 0; i_s < nSpecies; ++i_s)
     {
@@ -188,64 +187,11 @@ void BeamRelevant::ComputeDiags (int step)
         ParticleReal const m = myspc.getMass();
         ParticleReal const q = myspc.getCharge();
 
-        using PType = typename WarpXParticleContainer::SuperParticleType;
-
-        // number of reduction operations in first concurrent batch
-        constexpr size_t num_red_ops_1 = 8;
-        TypeMultiplier<amrex::ReduceOps, ReduceOpSum[num_red_ops_1]> reduce_ops_1;
-        using ReducedDataT1 = TypeMultiplier<amrex::ReduceData, ParticleReal[num_red_ops_1]>;
-
-        auto r1 = amrex::ParticleReduce<ReducedDataT1>(
-            myspc,
-            [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> ReducedDataT1::Type
-            {
-                const ParticleReal p_ux = p.rdata(PIdx::ux);
-                const ParticleReal p_uy = p.rdata(PIdx::uy);
-                const ParticleReal p_uz = p.rdata(PIdx::uz);
-                const ParticleReal p_us = p_ux*p_ux + p_uy*p_uy + p_uz*p_uz;
-                const ParticleReal p_w = p.rdata(PIdx::w);
-
-                ParticleReal p_x, p_y, p_z;
-                get_particle_position(p, p_x, p_y, p_z);
-
-                const ParticleReal p_x_mean = p_x*p_w;
-                const ParticleReal p_y_mean = p_y*p_w;
-                const ParticleReal p_z_mean = p_z*p_w;
-
-                const ParticleReal p_ux_mean = p_ux*p_w;
-                const ParticleReal p_uy_mean = p_uy*p_w;
-                const ParticleReal p_uz_mean = p_uz*p_w;
-                const ParticleReal p_gm_mean = std::sqrt(1.0_rt+p_us*inv_c2)*p_w;
+        // moments computed in a single pass over the particles,
+        // shared with the other particle reduced diagnostics
+        const ParticleMoments::Moments& moments = ParticleMoments::Get(m_beam_name, step);
 
-                return {p_w,
-                        p_x_mean, p_y_mean, p_z_mean,
-                        p_ux_mean, p_uy_mean, p_uz_mean,
-                        p_gm_mean};
-            },
-            reduce_ops_1);
-
-        std::vector<ParticleReal> values_per_rank_1st(num_red_ops_1);
-
-        /* contains in this order:
-         * w, x_mean, y_mean, z_mean
-         * ux_mean, uy_mean, uz_mean, gm_mean
-         */
-        amrex::constexpr_for<0, num_red_ops_1> ([&](auto i) {
-            values_per_rank_1st[i] = amrex::get<i>(r1);
-        });
-
-        // reduced sum over mpi ranks (allreduce)
-        amrex::ParallelAllReduce::Sum
-        ( values_per_rank_1st.data(), static_cast<int>(values_per_rank_1st.size()), ParallelDescriptor::Communicator());
-
-        const ParticleReal w_sum   = values_per_rank_1st.at(0);
-        const ParticleReal x_mean  = values_per_rank_1st.at(1) /= w_sum;
-        const ParticleReal y_mean  = values_per_rank_1st.at(2) /= w_sum;
-        const ParticleReal z_mean  = values_per_rank_1st.at(3) /= w_sum;
-        const ParticleReal ux_mean = values_per_rank_1st.at(4) /= w_sum;
-        const ParticleReal uy_mean = values_per_rank_1st.at(5) /= w_sum;
-        const ParticleReal uz_mean = values_per_rank_1st.at(6) /= w_sum;
-        const ParticleReal gm_mean = values_per_rank_1st.at(7) /= w_sum;
+        const ParticleReal w_sum = moments.w_sum;
 
         if (w_sum < std::numeric_limits<Real>::min() )
         {
@@ -254,77 +200,26 @@ void BeamRelevant::ComputeDiags (int step)
             return;
         }
 
-        // number of reduction operations in second concurrent batch
-        constexpr size_t num_red_ops_2 = 11;
-
-        TypeMultiplier<amrex::ReduceOps, ReduceOpSum[num_red_ops_2]> reduce_ops2;
-        using ReducedDataT2 = TypeMultiplier<amrex::ReduceData, ParticleReal[num_red_ops_2]>;
-
-        auto r2 = amrex::ParticleReduce<ReducedDataT2>(
-            myspc,
-            [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> ReducedDataT2::Type
-            {
-                const ParticleReal p_ux = p.rdata(PIdx::ux);
-                const ParticleReal p_uy = p.rdata(PIdx::uy);
-                const ParticleReal p_uz = p.rdata(PIdx::uz);
-                const ParticleReal p_us = p_ux*p_ux + p_uy*p_uy + p_uz*p_uz;
-                const ParticleReal p_gm = std::sqrt(1.0_rt+p_us*inv_c2);
-                const ParticleReal p_w = p.rdata(PIdx::w);
-
-                ParticleReal p_x, p_y, p_z;
-                get_particle_position(p, p_x, p_y, p_z);
-
-                const ParticleReal p_x_ms = (p_x-x_mean)*(p_x-x_mean)*p_w;
-                const ParticleReal p_y_ms = (p_y-y_mean)*(p_y-y_mean)*p_w;
-                const ParticleReal p_z_ms = (p_z-z_mean)*(p_z-z_mean)*p_w;
-
-                const ParticleReal p_ux_ms = (p_ux-ux_mean)*(p_ux-ux_mean)*p_w;
-                const ParticleReal p_uy_ms = (p_uy-uy_mean)*(p_uy-uy_mean)*p_w;
-                const ParticleReal p_uz_ms = (p_uz-uz_mean)*(p_uz-uz_mean)*p_w;
-                const ParticleReal p_gm_ms = (p_gm-gm_mean)*(p_gm-gm_mean)*p_w;
-
-                const ParticleReal p_xux = (p_x-x_mean)*(p_ux-ux_mean)*p_w;
-                const ParticleReal p_yuy = (p_y-y_mean)*(p_uy-uy_mean)*p_w;
-                const ParticleReal p_zuz = (p_z-z_mean)*(p_uz-uz_mean)*p_w;
-
-                const ParticleReal p_charge = q*p_w;
-
-                return {p_x_ms, p_y_ms, p_z_ms,
-                        p_ux_ms, p_uy_ms, p_uz_ms,
-                        p_gm_ms,
-                        p_xux, p_yuy, p_zuz,
-                        p_charge};
-            },
-            reduce_ops2);
-
-        std::vector<ParticleReal> values_per_rank_2nd(num_red_ops_2);
-
-        /* contains in this order:
-         * x_ms, y_ms, z_ms
-         * ux_ms, uy_ms, uz_ms,
-         * gm_ms
-         * xux, yuy, zuz,
-         * charge
-         */
-        amrex::constexpr_for<0, num_red_ops_2> ([&](auto i) {
-            values_per_rank_2nd[i] = amrex::get<i>(r2);
-        });
-
-        // reduced sum over mpi ranks (reduce to IO rank)
-        ParallelDescriptor::ReduceRealSum
-        ( values_per_rank_2nd.data(), static_cast<int>(values_per_rank_2nd.size()), ParallelDescriptor::IOProcessorNumber());
-
-        const ParticleReal x_ms   = values_per_rank_2nd.at(0) /= w_sum;
-        const ParticleReal y_ms   = values_per_rank_2nd.at(1) /= w_sum;
-        const ParticleReal z_ms   = values_per_rank_2nd.at(2) /= w_sum;
-        const ParticleReal ux_ms  = values_per_rank_2nd.at(3) /= w_sum;
-        const ParticleReal uy_ms  = values_per_rank_2nd.at(4) /= w_sum;
-        const ParticleReal uz_ms  = values_per_rank_2nd.at(5) /= w_sum;
-        const ParticleReal gm_ms  = values_per_rank_2nd.at(6) /= w_sum;
-        const ParticleReal xux    = values_per_rank_2nd.at(7) /= w_sum;
-        const ParticleReal yuy    = values_per_rank_2nd.at(8) /= w_sum;
-        const ParticleReal zuz    = values_per_rank_2nd.at(9) /= w_sum;
-        const ParticleReal charge = values_per_rank_2nd.at(10);
+        using Q = ParticleMoments::Quantity;
+        const ParticleReal x_mean  = moments.mean[Q::x];
+        const ParticleReal y_mean  = moments.mean[Q::y];
+        const ParticleReal z_mean  = moments.mean[Q::z];
+        const ParticleReal ux_mean = moments.mean[Q::ux];
+        const ParticleReal uy_mean = moments.mean[Q::uy];
+        const ParticleReal uz_mean = moments.mean[Q::uz];
+        const ParticleReal gm_mean = moments.mean[Q::gamma];
+
+        const ParticleReal x_ms   = moments.variance[Q::x];
+        const ParticleReal y_ms   = moments.variance[Q::y];
+        const ParticleReal z_ms   = moments.variance[Q::z];
+        const ParticleReal ux_ms  = moments.variance[Q::ux];
+        const ParticleReal uy_ms  = moments.variance[Q::uy];
+        const ParticleReal uz_ms  = moments.variance[Q::uz];
+        const ParticleReal gm_ms  = moments.variance[Q::gamma];
+        const ParticleReal xux    = moments.covariance[0];
+        const ParticleReal yuy    = moments.covariance[1];
+        const ParticleReal zuz    = moments.covariance[2];
+        const ParticleReal charge = q * w_sum;
 
         // save data
 #if (defined WARPX_DIM_3D || defined WARPX_DIM_RZ)
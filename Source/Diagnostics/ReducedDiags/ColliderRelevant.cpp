@@ -7,6 +7,7 @@
  */
 #include "ColliderRelevant.H"
 
+#include "Diagnostics/ReducedDiags/ParticleMoments.H"
 #include "Diagnostics/ReducedDiags/ReducedDiags.H"
 #include "FieldSolver/Fields.H"
 #if (defined WARPX_QED)
@@ -71,6 +72,9 @@ ColliderRelevant::ColliderRelevant (const std::string& rd_name)
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
         m_beam_name.size() == 2u,
         "Collider-relevant diagnostics must involve exactly two species");
+    for (const auto& name : m_beam_name) {
+        ParticleMoments::Register(name, m_intervals);
+    }
 
     // RZ coordinate is not supported
 #if (defined WARPX_DIM_RZ)
@@ -221,199 +225,31 @@ void ColliderRelevant::ComputeDiags (int step)
         // get charge
         amrex::ParticleReal const q = myspc.getCharge();
 
-        using PType = typename WarpXParticleContainer::SuperParticleType;
-
         num_dens[i_s] = myspc.GetChargeDensity(0);
         num_dens[i_s]->mult(1._prt/q);
 
-#if defined(WARPX_DIM_1D_Z)
-        // w_tot
-        amrex::Real w_tot = ReduceSum( myspc,
-            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-            {
-                return p.rdata(PIdx::w);
-            });
-        amrex::ParallelDescriptor::ReduceRealSum(w_tot);
-#elif defined(WARPX_DIM_XZ)
-        // w_tot
-        // x_ave,
-        // thetax_min, thetax_ave, thetax_max
-        amrex::ReduceOps<ReduceOpSum,
-                         ReduceOpSum,
-                         ReduceOpMin, ReduceOpSum, ReduceOpMax> reduce_ops;
-        auto r = amrex::ParticleReduce<amrex::ReduceData<Real,
-                                                         Real,
-                                                         Real, Real, Real>>(
-            myspc,
-            [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real,
-                                                                             Real,
-                                                                             Real, Real, Real>
-            {
-                const amrex::Real w  = p.rdata(PIdx::w);
-                const amrex::Real x = p.pos(0);
-                const amrex::Real ux = p.rdata(PIdx::ux);
-                const amrex::Real uz = p.rdata(PIdx::uz);
-                const amrex::Real thetax = std::atan2(ux, uz);
-                return {w, w*x, thetax, w*thetax, thetax};
-            },
-            reduce_ops);
-
-        amrex::Real w_tot  = amrex::get<0>(r);
-        amrex::Real x_ave  = amrex::get<1>(r);
-        amrex::Real thetax_min  = amrex::get<2>(r);
-        amrex::Real thetax_ave  = amrex::get<3>(r);
-        amrex::Real thetax_max  = amrex::get<4>(r);
-
-        amrex::ParallelDescriptor::ReduceRealSum({w_tot, x_ave, thetax_ave});
-        amrex::ParallelDescriptor::ReduceRealMin({thetax_min});
-        amrex::ParallelDescriptor::ReduceRealMax({thetax_max});
-
-        // x_std, thetax_std
-        amrex::Real x_std = 0.0_rt;
-        amrex::Real thetax_std = 0.0_rt;
-
-        if (w_tot > 0.0_rt)
-        {
-            x_ave = x_ave / w_tot;
-            thetax_ave = thetax_ave / w_tot;
-
-            amrex::ReduceOps<ReduceOpSum, ReduceOpSum> reduce_ops_std;
-            auto r_std = amrex::ParticleReduce<amrex::ReduceData<Real, Real>>(
-                myspc,
-                [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real>
-                {
-                    const amrex::Real w  = p.rdata(PIdx::w);
-                    const amrex::Real x = p.pos(0);
-                    const amrex::Real ux = p.rdata(PIdx::ux);
-                    const amrex::Real uz = p.rdata(PIdx::uz);
-                    const amrex::Real thetax = std::atan2(ux, uz);
-                    const amrex::Real tmp1 = (x - x_ave)*(x - x_ave)*w;
-                    const amrex::Real tmp2 = (thetax - thetax_ave)*(thetax - thetax_ave)*w;
-                    return {tmp1, tmp2};
-                },
-                reduce_ops_std);
-
-            x_std = amrex::get<0>(r_std);
-            thetax_std = amrex::get<1>(r_std);
-
-            amrex::ParallelDescriptor::ReduceRealSum({x_std, thetax_std});
-
-            x_std = std::sqrt(x_std / w_tot);
-            thetax_std = std::sqrt(thetax_std / w_tot);
-        }
-
-        m_data[get_idx("x_ave_"+m_beam_name[i_s])] = x_ave;
-        m_data[get_idx("x_std_"+m_beam_name[i_s])] = x_std;
-        m_data[get_idx("thetax_min_"+m_beam_name[i_s])] = thetax_min;
-        m_data[get_idx("thetax_ave_"+m_beam_name[i_s])] = thetax_ave;
-        m_data[get_idx("thetax_max_"+m_beam_name[i_s])] = thetax_max;
-        m_data[get_idx("thetax_std_"+m_beam_name[i_s])] = thetax_std;
-#elif defined(WARPX_DIM_3D)
-        // w_tot
-        // x_ave, y_ave,
-        // thetax_min, thetax_ave, thetax_max
-        // thetay_min, thetay_ave, thetay_max
-        amrex::ReduceOps<ReduceOpSum,
-                         ReduceOpSum, ReduceOpSum,
-                         ReduceOpMin, ReduceOpSum, ReduceOpMax,
-                         ReduceOpMin, ReduceOpSum, ReduceOpMax> reduce_ops;
-        auto r = amrex::ParticleReduce<amrex::ReduceData<Real,
-                                                         Real, Real,
-                                                         Real, Real, Real,
-                                                         Real, Real, Real>>(
-            myspc,
-            [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real,
-                                                                             Real, Real,
-                                                                             Real, Real, Real,
-                                                                             Real, Real, Real>
-            {
-                const amrex::Real w  = p.rdata(PIdx::w);
-                const amrex::Real x = p.pos(0);
-                const amrex::Real y = p.pos(1);
-                const amrex::Real ux = p.rdata(PIdx::ux);
-                const amrex::Real uy = p.rdata(PIdx::uy);
-                const amrex::Real uz = p.rdata(PIdx::uz);
-                const amrex::Real thetax = std::atan2(ux, uz);
-                const amrex::Real thetay = std::atan2(uy, uz);
-                return {w, w*x, w*y,
-                        thetax, w*thetax, thetax,
-                        thetay, w*thetay, thetay};
-            },
-            reduce_ops);
-
-        amrex::Real w_tot  = amrex::get<0>(r);
-        amrex::Real x_ave  = amrex::get<1>(r);
-        amrex::Real y_ave  = amrex::get<2>(r);
-        amrex::Real thetax_min  = amrex::get<3>(r);
-        amrex::Real thetax_ave  = amrex::get<4>(r);
-        amrex::Real thetax_max  = amrex::get<5>(r);
-        amrex::Real thetay_min  = amrex::get<6>(r);
-        amrex::Real thetay_ave  = amrex::get<7>(r);
-        amrex::Real thetay_max  = amrex::get<8>(r);
-
-        amrex::ParallelDescriptor::ReduceRealSum({w_tot, x_ave, y_ave, thetax_ave, thetay_ave});
-        amrex::ParallelDescriptor::ReduceRealMin({thetax_min, thetay_min});
-        amrex::ParallelDescriptor::ReduceRealMax({thetax_max, thetay_max});
-
-        // x_std, y_std, thetax_std, thetay_std
-        amrex::Real x_std = 0.0_rt;
-        amrex::Real y_std = 0.0_rt;
-        amrex::Real thetax_std = 0.0_rt;
-        amrex::Real thetay_std = 0.0_rt;
-
-        if (w_tot > 0.0_rt)
-        {
-            x_ave = x_ave / w_tot;
-            y_ave = y_ave / w_tot;
-            thetax_ave = thetax_ave / w_tot;
-            thetay_ave = thetay_ave / w_tot;
-
-            amrex::ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum> reduce_ops_std;
-            auto r_std = amrex::ParticleReduce<amrex::ReduceData<Real, Real, Real, Real>>(
-                myspc,
-                [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real, Real, Real>
-                {
-                    const amrex::Real w  = p.rdata(PIdx::w);
-                    const amrex::Real x = p.pos(0);
-                    const amrex::Real ux = p.rdata(PIdx::ux);
-                    const amrex::Real y = p.pos(1);
-                    const amrex::Real uy = p.rdata(PIdx::uy);
-                    const amrex::Real uz = p.rdata(PIdx::uz);
-                    const amrex::Real thetax = std::atan2(ux, uz);
-                    const amrex::Real thetay = std::atan2(uy, uz);
-                    const amrex::Real tmp1 = (x - x_ave)*(x - x_ave)*w;
-                    const amrex::Real tmp2 = (y - y_ave)*(y - y_ave)*w;
-                    const amrex::Real tmp3 = (thetax - thetax_ave)*(thetax - thetax_ave)*w;
-                    const amrex::Real tmp4 = (thetay - thetay_ave)*(thetay - thetay_ave)*w;
-                    return {tmp1, tmp2, tmp3, tmp4};
-                },
-                reduce_ops_std);
-
-            x_std = amrex::get<0>(r_std);
-            y_std = amrex::get<1>(r_std);
-            thetax_std = amrex::get<2>(r_std);
-            thetay_std = amrex::get<3>(r_std);
-
-            amrex::ParallelDescriptor::ReduceRealSum({x_std, y_std, thetax_std, thetay_std});
-
-            x_std = std::sqrt(x_std / w_tot);
-            y_std = std::sqrt(y_std / w_tot);
-            thetax_std = std::sqrt(thetax_std / w_tot);
-            thetay_std = std::sqrt(thetay_std / w_tot);
-        }
-
-        m_data[get_idx("x_ave_"+m_beam_name[i_s])] = x_ave;
-        m_data[get_idx("x_std_"+m_beam_name[i_s])] = x_std;
-        m_data[get_idx("y_ave_"+m_beam_name[i_s])] = y_ave;
-        m_data[get_idx("y_std_"+m_beam_name[i_s])] = y_std;
-        m_data[get_idx("thetax_min_"+m_beam_name[i_s])] = thetax_min;
-        m_data[get_idx("thetax_ave_"+m_beam_name[i_s])] = thetax_ave;
-        m_data[get_idx("thetax_max_"+m_beam_name[i_s])] = thetax_max;
-        m_data[get_idx("thetax_std_"+m_beam_name[i_s])] = thetax_std;
-        m_data[get_idx("thetay_min_"+m_beam_name[i_s])] = thetay_min;
-        m_data[get_idx("thetay_ave_"+m_beam_name[i_s])] = thetay_ave;
-        m_data[get_idx("thetay_max_"+m_beam_name[i_s])] = thetay_max;
-        m_data[get_idx("thetay_std_"+m_beam_name[i_s])] = thetay_std;
+        // moments computed in a single pass over the particles,
+        // shared with the other particle reduced diagnostics
+        const ParticleMoments::Moments& moments = ParticleMoments::Get(m_beam_name[i_s], step);
+        const amrex::Real w_tot = moments.w_sum;
+        amrex::ignore_unused(w_tot);
+
+#if defined(WARPX_DIM_XZ) || defined(WARPX_DIM_3D)
+        using Q = ParticleMoments::Quantity;
+        m_data[get_idx("x_ave_"+m_beam_name[i_s])] = moments.mean[Q::x];
+        m_data[get_idx("x_std_"+m_beam_name[i_s])] = std::sqrt(moments.variance[Q::x]);
+        m_data[get_idx("thetax_min_"+m_beam_name[i_s])] = moments.min[Q::thetax];
+        m_data[get_idx("thetax_ave_"+m_beam_name[i_s])] = moments.mean[Q::thetax];
+        m_data[get_idx("thetax_max_"+m_beam_name[i_s])] = moments.max[Q::thetax];
+        m_data[get_idx("thetax_std_"+m_beam_name[i_s])] = std::sqrt(moments.variance[Q::thetax]);
+#endif
+#if defined(WARPX_DIM_3D)
+        m_data[get_idx("y_ave_"+m_beam_name[i_s])] = moments.mean[Q::y];
+        m_data[get_idx("y_std_"+m_beam_name[i_s])] = std::sqrt(moments.variance[Q::y]);
+        m_data[get_idx("thetay_min_"+m_beam_name[i_s])] = moments.min[Q::thetay];
+        m_data[get_idx("thetay_ave_"+m_beam_name[i_s])] = moments.mean[Q::thetay];
+        m_data[get_idx("thetay_max_"+m_beam_name[i_s])] = moments.max[Q::thetay];
+        m_data[get_idx("thetay_std_"+m_beam_name[i_s])] = std::sqrt(moments.variance[Q::thetay]);
 #endif
 
 #if (defined WARPX_QED)
@@ -0,0 +1,97 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "ImplicitSolverStats.H"
+
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "FieldSolver/ImplicitSolvers/ImplicitSolver.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "WarpX.H"
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_REAL.H>
+
+#include <fstream>
+
+using namespace amrex::literals;
+
+// constructor
+ImplicitSolverStats::ImplicitSolverStats (const std::string& rd_name)
+: ReducedDiags{rd_name}
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        WarpX::evolve_scheme == EvolveScheme::ThetaImplicitEM ||
+        WarpX::evolve_scheme == EvolveScheme::SemiImplicitEM,
+        "ImplicitSolverStats reduced diagnostics require an implicit algo.evolve_scheme");
+
+    // resize data array
+    m_data.resize(m_nvars, 0.0_rt);
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        if ( m_write_header )
+        {
+            // open file
+            std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+            // write header row
+            int c = 0;
+            ofs << "#";
+            ofs << "[" << c++ << "]step()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]time(s)";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]nonlinear_iterations()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]linear_iterations()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]particle_pushes()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]residual_norm_abs()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]residual_norm_rel()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]total_nonlinear_iterations()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]total_linear_iterations()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]total_particle_pushes()";
+            ofs << std::endl;
+            // close file
+            ofs.close();
+        }
+    }
+}
+// end constructor
+
+void ImplicitSolverStats::ComputeDiags (int step)
+{
+    const ImplicitSolver* implicit_solver = WarpX::GetInstance().get_pointer_ImplicitSolver();
+    const NonlinearSolverStats& stats = implicit_solver->GetSolverStats();
+
+    // Accumulate the counts of every step, not only at the output intervals
+    if (step > m_last_step) {
+        m_total_iterations += stats.iterations;
+        m_total_linear_iterations += stats.linear_iterations;
+        m_total_rhs_evaluations += stats.rhs_evaluations;
+        m_last_step = step;
+    }
+
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+    int c = 0;
+    m_data[c++] = static_cast<amrex::Real>(stats.iterations);
+    m_data[c++] = static_cast<amrex::Real>(stats.linear_iterations);
+    m_data[c++] = static_cast<amrex::Real>(stats.rhs_evaluations);
+    m_data[c++] = stats.norm_abs;
+    m_data[c++] = stats.norm_rel;
+    m_data[c++] = static_cast<amrex::Real>(m_total_iterations);
+    m_data[c++] = static_cast<amrex::Real>(m_total_linear_iterations);
+    m_data[c++] = static_cast<amrex::Real>(m_total_rhs_evaluations);
+}
+// end void ImplicitSolverStats::ComputeDiags
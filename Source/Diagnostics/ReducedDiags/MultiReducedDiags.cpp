@@ -14,6 +14,7 @@
 #include "FieldProbe.H"
 #include "FieldMomentum.H"
 #include "FieldReduction.H"
+#include "ImplicitSolverStats.H"
 #include "LoadBalanceCosts.H"
 #include "LoadBalanceEfficiency.H"
 #include "ParticleEnergy.H"
@@ -21,8 +22,10 @@
 #include "ParticleHistogram.H"
 #include "ParticleHistogram2D.H"
 #include "ParticleMomentum.H"
+#include "ParticleMoments.H"
 #include "ParticleNumber.H"
 #include "RhoMaximum.H"
+#include "Telemetry.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXProfilerWrapper.H"
 
@@ -67,7 +70,9 @@ MultiReducedDiags::MultiReducedDiags ()
             {"ParticleHistogram2D",   [](CS s){return std::make_unique<ParticleHistogram2D>(s);}},
             {"ParticleNumber",        [](CS s){return std::make_unique<ParticleNumber>(s);}},
             {"ParticleExtrema",       [](CS s){return std::make_unique<ParticleExtrema>(s);}},
-            {"ChargeOnEB",  [](CS s){return std::make_unique<ChargeOnEB>(s);}}
+            {"ChargeOnEB",  [](CS s){return std::make_unique<ChargeOnEB>(s);}},
+            {"ImplicitSolverStats",   [](CS s){return std::make_unique<ImplicitSolverStats>(s);}},
+            {"Telemetry",             [](CS s){return std::make_unique<Telemetry>(s);}}
     };
     // loop over all reduced diags and fill m_multi_rd with requested reduced diags
     std::transform(m_rd_names.begin(), m_rd_names.end(), std::back_inserter(m_multi_rd),
@@ -111,6 +116,9 @@ void MultiReducedDiags::ComputeDiags (int step)
 {
     WARPX_PROFILE("MultiReducedDiags::ComputeDiags()");
 
+    // the particle moments shared by the diagnostics are computed again at each call
+    ParticleMoments::Clear();
+
     // loop over all reduced diags
     for (int i_rd = 0; i_rd < static_cast<int>(m_rd_names.size()); ++i_rd)
     {
@@ -7,6 +7,7 @@
 
 #include "ParticleExtrema.H"
 
+#include "Diagnostics/ReducedDiags/ParticleMoments.H"
 #include "Diagnostics/ReducedDiags/ReducedDiags.H"
 #if (defined WARPX_QED)
 #   include "Particles/ElementaryProcess/QEDInternals/QedChiFunctions.H"
@@ -61,6 +62,7 @@ ParticleExtrema::ParticleExtrema (const std::string& rd_name)
     // read species name
     const amrex::ParmParse pp_rd_name(rd_name);
     pp_rd_name.get("species",m_species_name);
+    ParticleMoments::Register(m_species_name, m_intervals);
 
     // get WarpX class object
     auto & warpx = WarpX::GetInstance();
@@ -164,9 +166,6 @@ void ParticleExtrema::ComputeDiags (int step)
     // get species names (std::vector<std::string>)
     const auto species_names = mypc.GetSpeciesNames();
 
-    // inverse of speed of light squared
-    amrex::Real constexpr inv_c2 = 1.0_rt / (PhysConst::c * PhysConst::c);
-
     // loop over species
     for (int i_s = 0; i_s < nSpecies; ++i_s)
     {
@@ -183,60 +182,27 @@ void ParticleExtrema::ComputeDiags (int step)
             m = PhysConst::m_e;
         }
 
-        using PType = typename WarpXParticleContainer::SuperParticleType;
-        using OpMin = amrex::ReduceOpMin;
-        using OpMax = amrex::ReduceOpMax;
-
-        amrex::ReduceOps<OpMin, OpMin, OpMin, OpMin,
-                         OpMax, OpMax, OpMax, OpMax> reduce_ops;
-        auto posminmax = amrex::ParticleReduce<amrex::ReduceData<amrex::Real, amrex::Real, amrex::Real, amrex::Real,
-                                                                 amrex::Real, amrex::Real, amrex::Real, amrex::Real>>(
-            myspc,
-            [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<amrex::Real, amrex::Real, amrex::Real, amrex::Real,
-                                                                             amrex::Real, amrex::Real, amrex::Real, amrex::Real>
-            {
-                amrex::ParticleReal x, y, z;
-                get_particle_position(p, x, y, z);
-                amrex::Real const w = p.rdata(PIdx::w);
-                return {w, x, y, z, w, x, y, z};
-            },
-            reduce_ops);
-
-        amrex::Real wmin = amrex::get<0>(posminmax);
-        amrex::Real xmin = amrex::get<1>(posminmax);
-        amrex::Real ymin = amrex::get<2>(posminmax);
-        amrex::Real zmin = amrex::get<3>(posminmax);
-        amrex::Real wmax = amrex::get<4>(posminmax);
-        amrex::Real xmax = amrex::get<5>(posminmax);
-        amrex::Real ymax = amrex::get<6>(posminmax);
-        amrex::Real zmax = amrex::get<7>(posminmax);
-
-        amrex::Real const gfactor = (is_photon ? 0._rt : 1._rt);
-        auto uminmax = amrex::ParticleReduce<amrex::ReduceData<amrex::Real, amrex::Real, amrex::Real, amrex::Real,
-                                                               amrex::Real, amrex::Real, amrex::Real, amrex::Real>>(
-            myspc,
-            [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<amrex::Real, amrex::Real, amrex::Real, amrex::Real,
-                                                                             amrex::Real, amrex::Real, amrex::Real, amrex::Real>
-            {
-                amrex::Real const ux = p.rdata(PIdx::ux);
-                amrex::Real const uy = p.rdata(PIdx::uy);
-                amrex::Real const uz = p.rdata(PIdx::uz);
-                amrex::Real const g = std::sqrt(gfactor + (ux*ux + uy*uy + uz*uz)*inv_c2);
-                return {g, ux, uy, uz, g, ux, uy, uz};
-            },
-            reduce_ops);
-
-        amrex::Real gmin = amrex::get<0>(uminmax);
-        amrex::Real uxmin = amrex::get<1>(uminmax);
-        amrex::Real uymin = amrex::get<2>(uminmax);
-        amrex::Real uzmin = amrex::get<3>(uminmax);
-        amrex::Real gmax = amrex::get<4>(uminmax);
-        amrex::Real uxmax = amrex::get<5>(uminmax);
-        amrex::Real uymax = amrex::get<6>(uminmax);
-        amrex::Real uzmax = amrex::get<7>(uminmax);
-
-        amrex::ParallelDescriptor::ReduceRealMin({xmin,ymin,zmin,uxmin,uymin,uzmin,gmin,wmin});
-        amrex::ParallelDescriptor::ReduceRealMax({xmax,ymax,zmax,uxmax,uymax,uzmax,gmax,wmax});
+        // extrema computed in a single pass over the particles,
+        // shared with the other particle reduced diagnostics
+        const ParticleMoments::Moments& moments = ParticleMoments::Get(m_species_name, step);
+        using Q = ParticleMoments::Quantity;
+
+        const amrex::Real xmin  = moments.min[Q::x];
+        const amrex::Real ymin  = moments.min[Q::y];
+        const amrex::Real zmin  = moments.min[Q::z];
+        const amrex::Real uxmin = moments.min[Q::ux];
+        const amrex::Real uymin = moments.min[Q::uy];
+        const amrex::Real uzmin = moments.min[Q::uz];
+        const amrex::Real gmin  = moments.min[Q::gamma];
+        const amrex::Real wmin  = moments.w_min;
+        const amrex::Real xmax  = moments.max[Q::x];
+        const amrex::Real ymax  = moments.max[Q::y];
+        const amrex::Real zmax  = moments.max[Q::z];
+        const amrex::Real uxmax = moments.max[Q::ux];
+        const amrex::Real uymax = moments.max[Q::uy];
+        const amrex::Real uzmax = moments.max[Q::uz];
+        const amrex::Real gmax  = moments.max[Q::gamma];
+        const amrex::Real wmax  = moments.w_max;
 
 #if (defined WARPX_QED)
         // get number of level (int)
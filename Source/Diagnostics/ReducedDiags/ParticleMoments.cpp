@@ -0,0 +1,331 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "ParticleMoments.H"
+
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/Pusher/GetAndSetPosition.H"
+#include "Particles/SpeciesPhysicalProperties.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/WarpXConst.H"
+#include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
+
+#include <AMReX_Algorithm.H>
+#include <AMReX_Array.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_Tuple.H>
+#include <AMReX_TypeList.H>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace amrex::literals;
+
+namespace
+{
+    using namespace ParticleMoments;
+
+    constexpr int nq = nquantities;
+
+    // Layout of the per-tile reduction: weight, reference values (first particle
+    // of the tile), first and second moments of the data shifted by the reference,
+    // shifted co-moments, then the minimum and maximum of each quantity and of the weight
+    constexpr int i_w   = 0;
+    constexpr int i_ref = i_w + 1;
+    constexpr int i_s1  = i_ref + nq;
+    constexpr int i_s2  = i_s1 + nq;
+    constexpr int i_sc  = i_s2 + nq;
+    constexpr int i_min = i_sc + 3;
+    constexpr int i_max = i_min + nq + 1;
+    constexpr int n_red = i_max + nq + 1;
+
+    /** Mergeable statistics of a set of particles: sum of the weights, means,
+     *  sums of the squared deviations and co-deviations from the means, extrema */
+    struct Partial
+    {
+        double w = 0.;
+        std::array<double, nq> mean{};
+        std::array<double, nq> m2{};
+        std::array<double, 3> c{};
+        std::array<double, nq+1> min;
+        std::array<double, nq+1> max;
+
+        Partial ()
+        {
+            min.fill(std::numeric_limits<amrex::ParticleReal>::max());
+            max.fill(std::numeric_limits<amrex::ParticleReal>::lowest());
+        }
+
+        static constexpr int packed_size = 1 + nq + nq + 3 + 2*(nq+1);
+
+        void Pack (double* p) const
+        {
+            *p++ = w;
+            for (const double v : mean) { *p++ = v; }
+            for (const double v : m2) { *p++ = v; }
+            for (const double v : c) { *p++ = v; }
+            for (const double v : min) { *p++ = v; }
+            for (const double v : max) { *p++ = v; }
+        }
+
+        void Unpack (const double* p)
+        {
+            w = *p++;
+            for (double& v : mean) { v = *p++; }
+            for (double& v : m2) { v = *p++; }
+            for (double& v : c) { v = *p++; }
+            for (double& v : min) { v = *p++; }
+            for (double& v : max) { v = *p++; }
+        }
+
+        /** Add the statistics of `b` (Chan, Golub and LeVeque pairwise update) */
+        void Merge (const Partial& b)
+        {
+            for (int q = 0; q <= nq; ++q) {
+                min[q] = std::min(min[q], b.min[q]);
+                max[q] = std::max(max[q], b.max[q]);
+            }
+            if (b.w <= 0.) { return; }
+            if (w <= 0.) {
+                w = b.w; mean = b.mean; m2 = b.m2; c = b.c;
+                return;
+            }
+            const double w_ab = w + b.w;
+            const double f = w*b.w/w_ab;
+            std::array<double, nq> delta{};
+            for (int q = 0; q < nq; ++q) { delta[q] = b.mean[q] - mean[q]; }
+            for (int q = 0; q < nq; ++q) { m2[q] += b.m2[q] + delta[q]*delta[q]*f; }
+            for (int k = 0; k < 3; ++k) { c[k] += b.c[k] + delta[Quantity::x+k]*delta[Quantity::ux+k]*f; }
+            for (int q = 0; q < nq; ++q) { mean[q] += delta[q]*b.w/w_ab; }
+            w = w_ab;
+        }
+    };
+
+    /** Values of the quantities of particle i of a tile */
+    struct GetQuantities
+    {
+        GetParticlePosition<PIdx> m_get_position;
+        const amrex::ParticleReal* AMREX_RESTRICT m_ux;
+        const amrex::ParticleReal* AMREX_RESTRICT m_uy;
+        const amrex::ParticleReal* AMREX_RESTRICT m_uz;
+        amrex::ParticleReal m_gfactor;
+
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        amrex::GpuArray<amrex::ParticleReal, nq> operator() (long i) const noexcept
+        {
+            constexpr amrex::ParticleReal inv_c2 = 1._prt/(PhysConst::c*PhysConst::c);
+            amrex::GpuArray<amrex::ParticleReal, nq> v;
+            m_get_position(i, v[Quantity::x], v[Quantity::y], v[Quantity::z]);
+            v[Quantity::ux] = m_ux[i];
+            v[Quantity::uy] = m_uy[i];
+            v[Quantity::uz] = m_uz[i];
+            v[Quantity::gamma] = std::sqrt(m_gfactor + (m_ux[i]*m_ux[i] + m_uy[i]*m_uy[i] + m_uz[i]*m_uz[i])*inv_c2);
+            v[Quantity::thetax] = std::atan2(m_ux[i], m_uz[i]);
+            v[Quantity::thetay] = std::atan2(m_uy[i], m_uz[i]);
+            return v;
+        }
+    };
+
+    /** Statistics of the particles of the current tile of pti */
+    Partial ReduceTile (WarpXParIter& pti, amrex::ParticleReal gfactor)
+    {
+        const long np = pti.numParticles();
+        Partial partial;
+        if (np == 0) { return partial; }
+
+        const auto& attribs = pti.GetAttribs();
+        const GetQuantities get_quantities{GetParticlePosition<PIdx>(pti),
+            attribs[PIdx::ux].dataPtr(), attribs[PIdx::uy].dataPtr(), attribs[PIdx::uz].dataPtr(), gfactor};
+        const amrex::ParticleReal* AMREX_RESTRICT wp = attribs[PIdx::w].dataPtr();
+
+        using ReduceOpsT = amrex::TypeMultiplier<amrex::ReduceOps,
+                                                 amrex::ReduceOpSum[i_min],
+                                                 amrex::ReduceOpMin[nq+1],
+                                                 amrex::ReduceOpMax[nq+1]>;
+        using ReduceDataT = amrex::TypeMultiplier<amrex::ReduceData, amrex::ParticleReal[n_red]>;
+        ReduceOpsT reduce_op;
+        ReduceDataT reduce_data(reduce_op);
+        using ReduceTuple = typename ReduceDataT::Type;
+        reduce_op.eval(np, reduce_data, [=] AMREX_GPU_DEVICE (long i) -> ReduceTuple
+        {
+            const auto v = get_quantities(i);
+            const auto ref = get_quantities(0);
+            const amrex::ParticleReal w = wp[i];
+            ReduceTuple t;
+            amrex::get<i_w>(t) = w;
+            amrex::constexpr_for<0, nq>([&] (auto q) {
+                const amrex::ParticleReal d = v[q] - ref[q];
+                amrex::get<i_ref+q>(t) = (i == 0) ? ref[q] : 0._prt;
+                amrex::get<i_s1+q>(t) = w*d;
+                amrex::get<i_s2+q>(t) = w*d*d;
+                amrex::get<i_min+q>(t) = v[q];
+                amrex::get<i_max+q>(t) = v[q];
+            });
+            amrex::constexpr_for<0, 3>([&] (auto k) {
+                amrex::get<i_sc+k>(t) = w*(v[Quantity::x+k] - ref[Quantity::x+k])
+                                         *(v[Quantity::ux+k] - ref[Quantity::ux+k]);
+            });
+            amrex::get<i_min+nq>(t) = w;
+            amrex::get<i_max+nq>(t) = w;
+            return t;
+        });
+        const auto r = reduce_data.value(reduce_op);
+
+        std::array<double, n_red> h{};
+        amrex::constexpr_for<0, n_red>([&] (auto n) { h[n] = amrex::get<n>(r); });
+
+        for (int q = 0; q <= nq; ++q) {
+            partial.min[q] = h[i_min+q];
+            partial.max[q] = h[i_max+q];
+        }
+        const double w = h[i_w];
+        if (w <= 0.) { return partial; }
+        partial.w = w;
+        for (int q = 0; q < nq; ++q) {
+            const double s1 = h[i_s1+q];
+            partial.mean[q] = h[i_ref+q] + s1/w;
+            partial.m2[q] = std::max(h[i_s2+q] - s1*s1/w, 0.);
+        }
+        for (int k = 0; k < 3; ++k) {
+            partial.c[k] = h[i_sc+k] - h[i_s1+Quantity::x+k]*h[i_s1+Quantity::ux+k]/w;
+        }
+        return partial;
+    }
+
+    /** Statistics of the particles of a species on this rank */
+    Partial ReduceSpecies (WarpXParticleContainer& myspc)
+    {
+        const amrex::ParticleReal gfactor = myspc.AmIA<PhysicalSpecies::photon>() ? 0._prt : 1._prt;
+
+        // The tiles are merged in a fixed order, independent of the number of threads
+        std::map<std::tuple<int, int, int>, Partial> tile_partials;
+        for (int lev = 0; lev <= myspc.finestLevel(); ++lev) {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+            for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti) {
+                const Partial partial = ReduceTile(pti, gfactor);
+#ifdef AMREX_USE_OMP
+#pragma omp critical (particle_moments_tiles)
+#endif
+                tile_partials[{lev, pti.index(), pti.LocalTileIndex()}] = partial;
+            }
+        }
+
+        Partial total;
+        for (const auto& kv : tile_partials) { total.Merge(kv.second); }
+        return total;
+    }
+
+    // Species registered by the diagnostics, with the intervals of the diagnostics
+    std::vector<std::pair<std::string, utils::parser::IntervalsParser>> registered;
+
+    // Moments computed at step cached_step
+    int cached_step = std::numeric_limits<int>::lowest();
+    std::map<std::string, Moments> cache;
+
+    /** Compute the moments of the species `names` in one pass each, and one MPI communication */
+    void Compute (const std::vector<std::string>& names)
+    {
+        WARPX_PROFILE("ParticleMoments::Compute()");
+
+        const auto& mypc = WarpX::GetInstance().GetPartContainer();
+        const int nspecies = static_cast<int>(names.size());
+        const int n = nspecies*Partial::packed_size;
+
+        std::vector<double> local(n);
+        for (int is = 0; is < nspecies; ++is) {
+            ReduceSpecies(mypc.GetParticleContainerFromName(names[is])).Pack(local.data() + is*Partial::packed_size);
+        }
+
+        const int nprocs = amrex::ParallelDescriptor::NProcs();
+#ifdef AMREX_USE_MPI
+        std::vector<double> all(static_cast<std::size_t>(n)*nprocs);
+        BL_MPI_REQUIRE( MPI_Allgather(local.data(), n, MPI_DOUBLE, all.data(), n, MPI_DOUBLE,
+                                      amrex::ParallelDescriptor::Communicator()) );
+#else
+        const std::vector<double>& all = local;
+#endif
+
+        for (int is = 0; is < nspecies; ++is) {
+            // The ranks are merged in the same order on all ranks
+            Partial total;
+            for (int rank = 0; rank < nprocs; ++rank) {
+                Partial partial;
+                partial.Unpack(all.data() + static_cast<std::size_t>(rank)*n + is*Partial::packed_size);
+                total.Merge(partial);
+            }
+
+            Moments& m = cache[names[is]];
+            m = Moments{};
+            m.w_sum = total.w;
+            m.w_min = total.min[nq];
+            m.w_max = total.max[nq];
+            for (int q = 0; q < nq; ++q) {
+                m.min[q] = total.min[q];
+                m.max[q] = total.max[q];
+            }
+            if (total.w > 0.) {
+                for (int q = 0; q < nq; ++q) {
+                    m.mean[q] = total.mean[q];
+                    m.variance[q] = total.m2[q]/total.w;
+                }
+                for (int k = 0; k < 3; ++k) { m.covariance[k] = total.c[k]/total.w; }
+            }
+        }
+    }
+}
+
+void
+ParticleMoments::Register (const std::string& species_name, const utils::parser::IntervalsParser& intervals)
+{
+    registered.emplace_back(species_name, intervals);
+}
+
+const ParticleMoments::Moments&
+ParticleMoments::Get (const std::string& species_name, int step)
+{
+    if (step != cached_step) {
+        cache.clear();
+        cached_step = step;
+
+        // All the (existing) species of the diagnostics active at this step
+        const auto species_names = WarpX::GetInstance().GetPartContainer().GetSpeciesNames();
+        std::vector<std::string> names;
+        for (const auto& [name, intervals] : registered) {
+            if (intervals.contains(step+1)
+                && std::find(species_names.begin(), species_names.end(), name) != species_names.end()
+                && std::find(names.begin(), names.end(), name) == names.end()) {
+                names.push_back(name);
+            }
+        }
+        if (std::find(names.begin(), names.end(), species_name) == names.end()) {
+            names.push_back(species_name);
+        }
+        Compute(names);
+    }
+    else if (cache.find(species_name) == cache.end()) {
+        Compute({species_name});
+    }
+    return cache.at(species_name);
+}
+
+void
+ParticleMoments::Clear ()
+{
+    cache.clear();
+    cached_step = std::numeric_limits<int>::lowest();
+}
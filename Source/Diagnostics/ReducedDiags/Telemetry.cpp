@@ -0,0 +1,169 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "Telemetry.H"
+
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/TelemetryTimers.H"
+#include "Utils/TextMsg.H"
+#include "WarpX.H"
+
+#include <AMReX_BaseFab.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Utility.H>
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+using namespace amrex;
+
+namespace
+{
+    /** Names of the data fields saved for each rank */
+    std::array<std::string, Telemetry::m_nDataFields> DataFieldNames ()
+    {
+        std::array<std::string, Telemetry::m_nDataFields> names;
+        int c = 0;
+        names[c++] = "wall_time";
+        for (auto const& name : telemetry::category_names) { names[c++] = name; }
+        names[c++] = "macroparticles";
+        names[c++] = "cells";
+        names[c++] = "fab_memory_hwm";
+        names[c++] = "scratch_memory_hwm";
+        return names;
+    }
+}
+
+// constructor
+Telemetry::Telemetry (const std::string& rd_name)
+: ReducedDiags{rd_name}
+{
+    const ParmParse pp_rd_name(rd_name);
+
+    std::string format = "jsonl";
+    pp_rd_name.query("format", format);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(format == "jsonl" || format == "binary",
+        rd_name + ".format must be jsonl or binary");
+    m_binary = (format == "binary");
+
+    telemetry::Enable();
+    m_last_time = amrex::second();
+
+    if (m_binary && ParallelDescriptor::IOProcessor() && m_write_header)
+    {
+        // The binary file only contains numbers: describe its layout in a separate file
+        std::ofstream ofs{m_path + m_rd_name + ".header", std::ofstream::out};
+        ofs << "# Each record contains " << 3 + ParallelDescriptor::NProcs()*m_nDataFields
+            << " float64 values: step, time(s), number of steps since the previous record,\n"
+            << "# then, for each of the " << ParallelDescriptor::NProcs() << " ranks:\n";
+        for (auto const& name : DataFieldNames()) { ofs << name << "\n"; }
+    }
+}
+// end constructor
+
+void Telemetry::ComputeDiags (int step)
+{
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+    auto & warpx = WarpX::GetInstance();
+
+    const auto seconds = telemetry::Collect();
+    const double now = amrex::second();
+
+    std::array<Real, m_nDataFields> local_data {};
+    int c = 0;
+    local_data[c++] = static_cast<Real>(now - m_last_time);
+    for (auto const s : seconds) { local_data[c++] = static_cast<Real>(s); }
+
+    // number of macroparticles on this rank
+    const auto & mypc = warpx.GetPartContainer();
+    Long num_particles = 0;
+    for (int i_s = 0; i_s < mypc.nSpecies(); ++i_s) {
+        num_particles += mypc.GetParticleContainer(i_s).TotalNumberOfParticles(true, true);
+    }
+    local_data[c++] = static_cast<Real>(num_particles);
+
+    // number of cells on this rank
+    Long num_cells = 0;
+    for (int lev = 0; lev <= warpx.finestLevel(); ++lev) {
+        const BoxArray& ba = warpx.boxArray(lev);
+        const DistributionMapping& dm = warpx.DistributionMap(lev);
+        for (int i = 0; i < static_cast<int>(ba.size()); ++i) {
+            if (dm[i] == ParallelDescriptor::MyProc()) { num_cells += ba[i].numPts(); }
+        }
+    }
+    local_data[c++] = static_cast<Real>(num_cells);
+
+    // memory high-water marks on this rank
+    local_data[c++] = static_cast<Real>(amrex::TotalBytesAllocatedInFabsHWM());
+    local_data[c++] = static_cast<Real>(warpx.ScratchPoolsHighWaterMark());
+
+    // gather the data of all ranks on the I/O rank
+    m_data.resize(static_cast<std::size_t>(ParallelDescriptor::NProcs())*m_nDataFields);
+    ParallelDescriptor::Gather(local_data.data(), m_nDataFields,
+                               m_data.data(), m_nDataFields,
+                               ParallelDescriptor::IOProcessorNumber());
+
+    m_num_steps = m_last_step ? step - *m_last_step : 0;
+    m_last_step = step;
+    m_last_time = now;
+}
+
+void Telemetry::WriteToFile (int step) const
+{
+    const std::string file_name = m_path + m_rd_name + "." + m_extension;
+    const Real time = WarpX::GetInstance().gett_new(0);
+    const int nprocs = ParallelDescriptor::NProcs();
+
+    if (m_binary)
+    {
+        std::ofstream ofs{file_name, std::ofstream::out | std::ofstream::app | std::ofstream::binary};
+        std::vector<double> record;
+        record.reserve(3 + m_data.size());
+        record.push_back(static_cast<double>(step+1));
+        record.push_back(static_cast<double>(time));
+        record.push_back(static_cast<double>(m_num_steps));
+        for (auto const& item : m_data) { record.push_back(static_cast<double>(item)); }
+        ofs.write(reinterpret_cast<const char*>(record.data()),
+                  static_cast<std::streamsize>(record.size()*sizeof(double)));
+        return;
+    }
+
+    // one JSON object per line
+    const auto names = DataFieldNames();
+    std::ofstream ofs{file_name, std::ofstream::out | std::ofstream::app};
+    ofs << std::setprecision(m_precision) << std::scientific;
+    ofs << "{\"step\": " << step+1 << ", \"time\": " << time
+        << ", \"steps\": " << m_num_steps << ", \"ranks\": [";
+    for (int rank = 0; rank < nprocs; ++rank)
+    {
+        ofs << (rank == 0 ? "" : ", ") << "{\"rank\": " << rank;
+        for (int i = 0; i < m_nDataFields; ++i)
+        {
+            const Real value = m_data[rank*m_nDataFields + i];
+            ofs << ", \"" << names[i] << "\": ";
+            // counts and memory sizes are integers
+            if (i > telemetry::num_categories) {
+                ofs << static_cast<std::int64_t>(value);
+            } else {
+                ofs << value;
+            }
+        }
+        ofs << "}";
+    }
+    ofs << "]}" << std::endl;
+}
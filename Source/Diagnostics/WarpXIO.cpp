@@ -12,6 +12,7 @@
 #    include "BoundaryConditions/PML_RZ.H"
 #endif
 #include "FieldIO.H"
+#include "FlushFormats/CheckpointDelta.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXProfilerWrapper.H"
@@ -274,6 +275,21 @@ WarpX::InitFromCheckpoint ()
 
     const int nlevs = finestLevel()+1;
 
+    // For a delta checkpoint, the fields are composed from its base checkpoint
+    // and the boxes that changed since then
+    const std::string restart_basefile = CheckpointDelta::GetBaseCheckpoint(restart_chkfile);
+    if (!restart_basefile.empty()) {
+        amrex::Print() << Utils::TextMsg::Info(
+            "restart from delta checkpoint, with base checkpoint " + restart_basefile);
+    }
+    const auto read_field = [&] (amrex::MultiFab& mf, int lev, const std::string& name)
+    {
+        CheckpointDelta::Read(mf,
+            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, name),
+            restart_basefile.empty() ? std::string{} :
+            amrex::MultiFabFileFullPrefix(lev, restart_basefile, level_prefix, name));
+    };
+
     // Initialize the field data
     for (int lev = 0; lev < nlevs; ++lev)
     {
@@ -294,86 +310,56 @@ WarpX::InitFromCheckpoint ()
             }
         }
 
-        VisMF::Read(*Efield_fp[lev][0],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_fp"));
-        VisMF::Read(*Efield_fp[lev][1],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_fp"));
-        VisMF::Read(*Efield_fp[lev][2],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_fp"));
+        read_field(*Efield_fp[lev][0], lev, "Ex_fp");
+        read_field(*Efield_fp[lev][1], lev, "Ey_fp");
+        read_field(*Efield_fp[lev][2], lev, "Ez_fp");
 
-        VisMF::Read(*Bfield_fp[lev][0],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_fp"));
-        VisMF::Read(*Bfield_fp[lev][1],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_fp"));
-        VisMF::Read(*Bfield_fp[lev][2],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_fp"));
+        read_field(*Bfield_fp[lev][0], lev, "Bx_fp");
+        read_field(*Bfield_fp[lev][1], lev, "By_fp");
+        read_field(*Bfield_fp[lev][2], lev, "Bz_fp");
 
         if (WarpX::fft_do_time_averaging)
         {
-            VisMF::Read(*Efield_avg_fp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_avg_fp"));
-            VisMF::Read(*Efield_avg_fp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_avg_fp"));
-            VisMF::Read(*Efield_avg_fp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_avg_fp"));
-
-            VisMF::Read(*Bfield_avg_fp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_avg_fp"));
-            VisMF::Read(*Bfield_avg_fp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_avg_fp"));
-            VisMF::Read(*Bfield_avg_fp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_avg_fp"));
+            read_field(*Efield_avg_fp[lev][0], lev, "Ex_avg_fp");
+            read_field(*Efield_avg_fp[lev][1], lev, "Ey_avg_fp");
+            read_field(*Efield_avg_fp[lev][2], lev, "Ez_avg_fp");
+
+            read_field(*Bfield_avg_fp[lev][0], lev, "Bx_avg_fp");
+            read_field(*Bfield_avg_fp[lev][1], lev, "By_avg_fp");
+            read_field(*Bfield_avg_fp[lev][2], lev, "Bz_avg_fp");
         }
 
         if (is_synchronized) {
-            VisMF::Read(*current_fp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_fp"));
-            VisMF::Read(*current_fp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_fp"));
-            VisMF::Read(*current_fp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_fp"));
+            read_field(*current_fp[lev][0], lev, "jx_fp");
+            read_field(*current_fp[lev][1], lev, "jy_fp");
+            read_field(*current_fp[lev][2], lev, "jz_fp");
         }
 
         if (lev > 0)
         {
-            VisMF::Read(*Efield_cp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_cp"));
-            VisMF::Read(*Efield_cp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_cp"));
-            VisMF::Read(*Efield_cp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_cp"));
-
-            VisMF::Read(*Bfield_cp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_cp"));
-            VisMF::Read(*Bfield_cp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_cp"));
-            VisMF::Read(*Bfield_cp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_cp"));
+            read_field(*Efield_cp[lev][0], lev, "Ex_cp");
+            read_field(*Efield_cp[lev][1], lev, "Ey_cp");
+            read_field(*Efield_cp[lev][2], lev, "Ez_cp");
+
+            read_field(*Bfield_cp[lev][0], lev, "Bx_cp");
+            read_field(*Bfield_cp[lev][1], lev, "By_cp");
+            read_field(*Bfield_cp[lev][2], lev, "Bz_cp");
 
             if (WarpX::fft_do_time_averaging)
             {
-                VisMF::Read(*Efield_avg_cp[lev][0],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_avg_cp"));
-                VisMF::Read(*Efield_avg_cp[lev][1],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_avg_cp"));
-                VisMF::Read(*Efield_avg_cp[lev][2],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_avg_cp"));
-
-                VisMF::Read(*Bfield_avg_cp[lev][0],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_avg_cp"));
-                VisMF::Read(*Bfield_avg_cp[lev][1],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_avg_cp"));
-                VisMF::Read(*Bfield_avg_cp[lev][2],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_avg_cp"));
+                read_field(*Efield_avg_cp[lev][0], lev, "Ex_avg_cp");
+                read_field(*Efield_avg_cp[lev][1], lev, "Ey_avg_cp");
+                read_field(*Efield_avg_cp[lev][2], lev, "Ez_avg_cp");
+
+                read_field(*Bfield_avg_cp[lev][0], lev, "Bx_avg_cp");
+                read_field(*Bfield_avg_cp[lev][1], lev, "By_avg_cp");
+                read_field(*Bfield_avg_cp[lev][2], lev, "Bz_avg_cp");
             }
 
             if (is_synchronized) {
-                VisMF::Read(*current_cp[lev][0],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_cp"));
-                VisMF::Read(*current_cp[lev][1],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_cp"));
-                VisMF::Read(*current_cp[lev][2],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_cp"));
+                read_field(*current_cp[lev][0], lev, "jx_cp");
+                read_field(*current_cp[lev][1], lev, "jy_cp");
+                read_field(*current_cp[lev][2], lev, "jz_cp");
             }
         }
     }
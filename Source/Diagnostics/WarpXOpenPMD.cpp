@@ -89,6 +89,67 @@ namespace detail
         return camelString;
     }
 
+    /** Create the JSON string of operator or engine parameters
+     *
+     * @return comma-separated "key": "value" pairs
+     */
+    inline std::string
+    getParametersString (std::map< std::string, std::string > const & parameters)
+    {
+        std::string str_parameters;
+        for (const auto& kv : parameters) {
+            if (!str_parameters.empty()) { str_parameters.append(",\n"); }
+            str_parameters.append(std::string(12, ' '))         /* just pretty alignment */
+                    .append("\"").append(kv.first).append("\": ")    /* key */
+                    .append("\"").append(kv.second).append("\""); /* value (as string) */
+        }
+        return str_parameters;
+    }
+
+    /** Create the option string for a dataset
+     *
+     * @param operator_type ADIOS2 operator (compressor) for this dataset, or empty
+     * @param operator_parameters parameters of the ADIOS2 operator
+     * @param resizable whether the dataset can be resized (e.g., for BTD)
+     * @return JSON option string for openPMD::Dataset
+     */
+    inline std::string
+    getDatasetOptions (std::string const & operator_type,
+                       std::map< std::string, std::string > const & operator_parameters,
+                       bool resizable)
+    {
+        if (operator_type.empty()) {
+            return resizable ? "{ \"resizable\": true }" : "{}";
+        }
+
+        std::string options = "{";
+        if (resizable) {
+            options += "\n  \"resizable\": true,";
+        }
+        options += R"END(
+  "adios2": {
+    "dataset": {
+      "operators": [
+        {
+          "type": ")END";
+        options += operator_type + "\"";
+
+        std::string const op_parameters = getParametersString(operator_parameters);
+        if (!op_parameters.empty()) {
+            options += R"END(,
+          "parameters": {
+)END";
+            options += op_parameters + "\n          }";
+        }
+        options += R"END(
+        }
+      ]
+    }
+  }
+})END";
+        return options;
+    }
+
     /** Create the option string
      *
      * @return JSON option string for openPMD::Series
@@ -109,21 +170,8 @@ namespace detail
         std::string op_block;
         std::string en_block;
 
-        std::string op_parameters;
-        for (const auto& kv : operator_parameters) {
-            if (!op_parameters.empty()) { op_parameters.append(",\n"); }
-            op_parameters.append(std::string(12, ' '))         /* just pretty alignment */
-                    .append("\"").append(kv.first).append("\": ")    /* key */
-                    .append("\"").append(kv.second).append("\""); /* value (as string) */
-        }
-
-        std::string en_parameters;
-        for (const auto& kv : engine_parameters) {
-            if (!en_parameters.empty()) { en_parameters.append(",\n"); }
-            en_parameters.append(std::string(12, ' '))         /* just pretty alignment */
-                    .append("\"").append(kv.first).append("\": ")    /* key */
-                    .append("\"").append(kv.second).append("\""); /* value (as string) */
-        }
+        std::string const op_parameters = getParametersString(operator_parameters);
+        std::string const en_parameters = getParametersString(engine_parameters);
 
         // create the outer-level blocks
         top_block = R"END(
@@ -379,6 +427,8 @@ WarpXOpenPMDPlot::WarpXOpenPMDPlot (
     const std::map< std::string, std::string >& operator_parameters,
     const std::string& engine_type,
     const std::map< std::string, std::string >& engine_parameters,
+    const std::map< std::string, std::string >& dataset_operator_types,
+    const std::map< std::string, std::map< std::string, std::string > >& dataset_operator_parameters,
     const std::vector<bool>& fieldPMLdirections,
     const std::string& authors)
     : m_Series(nullptr),
@@ -387,12 +437,29 @@ WarpXOpenPMDPlot::WarpXOpenPMDPlot (
       m_Encoding(ie),
       m_OpenPMDFileType{openPMDFileType},
       m_fieldPMLdirections{fieldPMLdirections},
-      m_authors{authors}
+      m_authors{authors},
+      m_dataset_operator_types{dataset_operator_types},
+      m_dataset_operator_parameters{dataset_operator_parameters}
 {
     m_OpenPMDoptions = detail::getSeriesOptions(operator_type, operator_parameters,
                                                 engine_type, engine_parameters);
 }
 
+std::string
+WarpXOpenPMDPlot::GetDatasetOptions (std::string const& name, bool resizable) const
+{
+    auto const it = m_dataset_operator_types.find(name);
+    if (it == m_dataset_operator_types.end()) {
+        return detail::getDatasetOptions("", {}, resizable);
+    }
+    auto const it_params = m_dataset_operator_parameters.find(name);
+    return detail::getDatasetOptions(
+        it->second,
+        it_params == m_dataset_operator_parameters.end() ?
+            std::map< std::string, std::string >{} : it_params->second,
+        resizable);
+}
+
 WarpXOpenPMDPlot::~WarpXOpenPMDPlot ()
 {
   if( m_Series )
@@ -707,9 +774,11 @@ WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
     // this setup stage also implicitly calls "makeEmpty" if needed (i.e., is_last_flush_and_never_particles)
     //   for BTD, we call this multiple times as we may resize in subsequent dumps if number of particles in the buffer > 0
     if (doParticleSetup || is_resizing_flush) {
-        SetupPos(currSpecies, positionComponents, NewParticleVectorSize, isBTD);
+        // per-species ADIOS2 operator (compressor), if any
+        std::string const dataset_options = GetDatasetOptions(name, isBTD);
+        SetupPos(currSpecies, positionComponents, NewParticleVectorSize, dataset_options);
         SetupRealProperties(pc, currSpecies, write_real_comp, real_comp_names, write_int_comp, int_comp_names,
-                            NewParticleVectorSize, isBTD);
+                            NewParticleVectorSize, dataset_options);
     }
 
     if (is_last_flush_to_step) {
@@ -807,10 +876,8 @@ WarpXOpenPMDPlot::SetupRealProperties (ParticleContainer const * pc,
                       const amrex::Vector<std::string>& real_comp_names,
                       const amrex::Vector<int>& write_int_comp,
                       const amrex::Vector<std::string>& int_comp_names,
-                      const unsigned long long np, bool const isBTD) const
+                      const unsigned long long np, std::string const& options) const
 {
-    std::string options = "{}";
-    if (isBTD) { options = "{ \"resizable\": true }"; }
     auto dtype_real = openPMD::Dataset(openPMD::determineDatatype<amrex::ParticleReal>(), {np}, options);
     auto dtype_int  = openPMD::Dataset(openPMD::determineDatatype<int>(), {np}, options);
     //
@@ -980,10 +1047,8 @@ WarpXOpenPMDPlot::SetupPos (
     openPMD::ParticleSpecies& currSpecies,
     std::vector<std::string> const & positionComponents,
     const unsigned long long& np,
-    bool const isBTD)
+    std::string const& options)
 {
-    std::string options = "{}";
-    if (isBTD) { options = "{ \"resizable\": true }"; }
     auto realType = openPMD::Dataset(openPMD::determineDatatype<amrex::ParticleReal>(), {np}, options);
     auto idType = openPMD::Dataset(openPMD::determineDatatype< uint64_t >(), {np}, options);
 
@@ -1210,7 +1275,8 @@ WarpXOpenPMDPlot::SetupMeshComp (openPMD::Mesh& mesh,
                                  std::string const& comp_name,
                                  std::string const& field_name,
                                  amrex::MultiFab const& mf,
-                                 bool var_in_theta_mode) const
+                                 bool var_in_theta_mode,
+                                 std::string const& dataset_options) const
 {
     auto mesh_comp = mesh[comp_name];
     amrex::Box const & global_box = full_geom.Domain();
@@ -1229,7 +1295,7 @@ WarpXOpenPMDPlot::SetupMeshComp (openPMD::Mesh& mesh,
 
     // Prepare the type of dataset that will be written
     openPMD::Datatype const datatype = openPMD::determineDatatype<amrex::Real>();
-    auto const dataset = openPMD::Dataset(datatype, global_size);
+    auto const dataset = openPMD::Dataset(datatype, global_size, dataset_options);
     mesh.setDataOrder(openPMD::Mesh::DataOrder::C);
     if (var_in_theta_mode) {
         mesh.setGeometry("thetaMode");
@@ -1396,7 +1462,8 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                                         comp_name,
                                         field_name,
                                         mf[lev],
-                                        var_in_theta_mode );
+                                        var_in_theta_mode,
+                                        GetDatasetOptions(varname_no_mode, false) );
                     }
                 } else {
                     auto mesh = meshes[field_name];
@@ -1406,7 +1473,8 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                                         comp_name,
                                         field_name,
                                         mf[lev],
-                                        var_in_theta_mode );
+                                        var_in_theta_mode,
+                                        GetDatasetOptions(varname_no_mode, false) );
                     }
                 }
             }
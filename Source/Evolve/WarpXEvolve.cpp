@@ -28,6 +28,7 @@
 #include "Fluids/WarpXFluidContainer.H"
 #include "Particles/ParticleBoundaryBuffer.H"
 #include "Python/callbacks.H"
+#include "Utils/TelemetryTimers.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXUtil.H"
@@ -44,6 +45,7 @@
 #include <AMReX_IntVect.H>
 #include <AMReX_LayoutData.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_Print.H>
 #include <AMReX_REAL.H>
@@ -266,14 +268,20 @@ WarpX::Evolve (int numsteps)
         // in the evolve timing.
         ExecutePythonCallback("afterstep");
 
-        /// reduced diags
-        if (reduced_diags->m_plot_rd != 0)
         {
-            reduced_diags->LoadBalance();
-            reduced_diags->ComputeDiags(step);
-            reduced_diags->WriteToFile(step);
+            // Derived fields (e.g. rho) are computed once for all the diagnostics below
+            const DerivedFieldCache::Scope derived_field_cache_scope(m_derived_field_cache);
+            const telemetry::ScopedTimer telemetry_timer(telemetry::Category::Diagnostics);
+
+            /// reduced diags
+            if (reduced_diags->m_plot_rd != 0)
+            {
+                reduced_diags->LoadBalance();
+                reduced_diags->ComputeDiags(step);
+                reduced_diags->WriteToFile(step);
+            }
+            multi_diags->FilterComputePackFlush( step );
         }
-        multi_diags->FilterComputePackFlush( step );
 
         // execute afterdiagnostic callbacks
         ExecutePythonCallback("afterdiagnostics");
@@ -312,6 +320,13 @@ WarpX::Evolve (int numsteps)
         if (m_exit_loop_due_to_interrupt_signal) { ExecutePythonCallback("onbreaksignal"); }
     }
 
+    if (verbose) {
+        auto scratch_bytes = static_cast<amrex::Long>(ScratchPoolsHighWaterMark());
+        amrex::ParallelDescriptor::ReduceLongMax(scratch_bytes);
+        amrex::Print() << "Scratch pool high-water mark (max over ranks) = "
+                       << scratch_bytes << " bytes\n";
+    }
+
     amrex::Print() <<
         ablastr::warn_manager::GetWMInstance().PrintGlobalWarnings("THE END");
 }
@@ -382,6 +397,15 @@ WarpX::OneStep_nosub (Real cur_time)
                 FillBoundaryG(guard_cells.ng_alloc_G, WarpX::sync_nodal_points);
             }
         }
+    } else if (do_fdtd_temporal_blocking) {
+        EvolveEBBlocked(dt[0]); // We now have E^{n+1} and B^{n+1}
+
+        // As with the FDTD push below, the guard cells of E are up-to-date
+        // and those of B are outdated
+        FillBoundaryE(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
+        if (safe_guard_cells) {
+            FillBoundaryB(guard_cells.ng_alloc_EB);
+        }
     } else {
         EvolveF(0.5_rt * dt[0], DtType::FirstHalf);
         EvolveG(0.5_rt * dt[0], DtType::FirstHalf);
@@ -16,6 +16,7 @@
 #include "Utils/Parser/ParserUtils.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
+#include "Utils/TelemetryTimers.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXProfilerWrapper.H"
 
@@ -50,7 +51,9 @@
 #   include <AMReX_EBFabFactory.H>
 #endif
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <memory>
 #include <string>
 
@@ -61,6 +64,7 @@ void
 WarpX::ComputeSpaceChargeField (bool const reset_fields)
 {
     WARPX_PROFILE("WarpX::ComputeSpaceChargeField");
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::FieldSolve);
     if (reset_fields) {
         // Reset all E and B fields to 0, before calculating space-charge fields
         WARPX_PROFILE("WarpX::ComputeSpaceChargeField::reset_fields");
@@ -80,11 +84,23 @@ WarpX::ComputeSpaceChargeField (bool const reset_fields)
         // Loop over the species and add their space-charge contribution to E and B.
         // Note that the fields calculated here does not include the E field
         // due to simulation boundary potentials
+        amrex::Vector<WarpXParticleContainer*> species_with_self_fields;
         for (int ispecies=0; ispecies<mypc->nSpecies(); ispecies++){
             WarpXParticleContainer& species = mypc->GetParticleContainer(ispecies);
-            if (species.initialize_self_fields ||
-                (electrostatic_solver_id == ElectrostaticSolverAlgo::Relativistic)) {
-                AddSpaceChargeField(species);
+            if ((species.initialize_self_fields ||
+                (electrostatic_solver_id == ElectrostaticSolverAlgo::Relativistic)) &&
+                (species.getCharge() != 0)) {
+                species_with_self_fields.push_back(&species);
+            }
+        }
+        if (self_fields_beta_bins > 0) {
+            // Species with similar velocities share one deposition and one solve
+            for (auto const& species_group : GroupSpeciesByBeta(species_with_self_fields)) {
+                AddSpaceChargeField(species_group);
+            }
+        } else {
+            for (auto* species : species_with_self_fields) {
+                AddSpaceChargeField(*species);
             }
         }
 
@@ -142,12 +158,69 @@ WarpX::AddBoundaryField ()
     computeB( Bfield_fp, phi, beta );
 }
 
+amrex::Vector<amrex::Vector<WarpXParticleContainer*>>
+WarpX::GroupSpeciesByBeta (amrex::Vector<WarpXParticleContainer*> const& species) const
+{
+    const auto nspecies = static_cast<int>(species.size());
+    if (nspecies == 0) { return {}; }
+
+    // Mean beta of each species, and charge-weighted mean beta of all species
+    amrex::Vector<std::array<Real, 3>> beta(nspecies);
+    std::array<Real, 3> beta_all = {0._rt, 0._rt, 0._rt};
+    for (int isp = 0; isp < nspecies; ++isp) {
+        bool const local_average = false; // Average across all MPI ranks
+        std::array<ParticleReal, 3> const beta_pr = species[isp]->meanParticleVelocity(local_average);
+        auto const weight = static_cast<Real>(
+            std::abs(species[isp]->getCharge()) * species[isp]->sumParticleWeight(local_average));
+        for (int i = 0; i < 3; ++i) {
+            beta[isp][i] = static_cast<Real>(beta_pr[i]/PhysConst::c);
+            beta_all[i] += weight * beta[isp][i];
+        }
+    }
+
+    // The species are binned according to their beta along the mean direction of motion
+    Real const norm = std::sqrt(beta_all[0]*beta_all[0] + beta_all[1]*beta_all[1] + beta_all[2]*beta_all[2]);
+    std::array<Real, 3> direction = {0._rt, 0._rt, 1._rt};
+    if (norm > 0._rt) {
+        for (int i = 0; i < 3; ++i) { direction[i] = beta_all[i]/norm; }
+    }
+    amrex::Vector<Real> beta_proj(nspecies);
+    for (int isp = 0; isp < nspecies; ++isp) {
+        beta_proj[isp] = beta[isp][0]*direction[0] + beta[isp][1]*direction[1] + beta[isp][2]*direction[2];
+    }
+    Real const beta_min = *std::min_element(beta_proj.begin(), beta_proj.end());
+    Real const beta_max = *std::max_element(beta_proj.begin(), beta_proj.end());
+
+    amrex::Vector<amrex::Vector<WarpXParticleContainer*>> bins(self_fields_beta_bins);
+    for (int isp = 0; isp < nspecies; ++isp) {
+        int ibin = 0;
+        if (beta_max > beta_min) {
+            ibin = static_cast<int>((beta_proj[isp] - beta_min)/(beta_max - beta_min)*self_fields_beta_bins);
+            ibin = std::min(ibin, self_fields_beta_bins - 1);
+        }
+        bins[ibin].push_back(species[isp]);
+    }
+    bins.erase(std::remove_if(bins.begin(), bins.end(), [](auto const& bin){ return bin.empty(); }),
+               bins.end());
+    return bins;
+}
+
 void
 WarpX::AddSpaceChargeField (WarpXParticleContainer& pc)
+{
+    if (pc.getCharge() == 0) {
+        return;
+    }
+
+    AddSpaceChargeField(amrex::Vector<WarpXParticleContainer*>{&pc});
+}
+
+void
+WarpX::AddSpaceChargeField (amrex::Vector<WarpXParticleContainer*> const& species_group)
 {
     WARPX_PROFILE("WarpX::AddSpaceChargeField");
 
-    if (pc.getCharge() == 0) {
+    if (species_group.empty()) {
         return;
     }
 
@@ -186,14 +259,17 @@ WarpX::AddSpaceChargeField (WarpXParticleContainer& pc)
     }
 
     // Deposit particle charge density (source of Poisson solver)
+    // of all the species of the group in the same MultiFab
     // The options below are identical to those in MultiParticleContainer::DepositCharge
     bool const local = true;
     bool const reset = false;
     bool const apply_boundary_and_scale_volume = true;
     bool const interpolate_across_levels = false;
-    if ( !pc.do_not_deposit) {
-        pc.DepositCharge(rho, local, reset, apply_boundary_and_scale_volume,
-                              interpolate_across_levels);
+    for (auto* pc : species_group) {
+        if ( !pc->do_not_deposit) {
+            pc->DepositCharge(rho, local, reset, apply_boundary_and_scale_volume,
+                                   interpolate_across_levels);
+        }
     }
     for (int lev = 0; lev <= max_level; lev++) {
         if (lev > 0) {
@@ -204,18 +280,40 @@ WarpX::AddSpaceChargeField (WarpXParticleContainer& pc)
     }
     SyncRho(rho, rho_coarse, charge_buf); // Apply filter, perform MPI exchange, interpolate across levels
 
-    // Get the particle beta vector
+    // Get the particle beta vector: for a group of species, this is the
+    // mean of the beta of each species, weighted by its total charge
     bool const local_average = false; // Average across all MPI ranks
-    std::array<ParticleReal, 3> beta_pr = pc.meanParticleVelocity(local_average);
-    std::array<Real, 3> beta;
-    for (int i=0 ; i < static_cast<int>(beta.size()) ; i++) {
-        beta[i] = beta_pr[i]/PhysConst::c; // Normalize
+    std::array<Real, 3> beta = {0._rt, 0._rt, 0._rt};
+    Real total_weight = 0._rt;
+    for (auto* pc : species_group) {
+        std::array<ParticleReal, 3> beta_pr = pc->meanParticleVelocity(local_average);
+        auto const weight = (species_group.size() == 1) ? 1._rt : static_cast<Real>(
+            std::abs(pc->getCharge()) * pc->sumParticleWeight(local_average));
+        for (int i=0 ; i < static_cast<int>(beta.size()) ; i++) {
+            beta[i] += weight * beta_pr[i]/PhysConst::c; // Normalize
+        }
+        total_weight += weight;
+    }
+    if (total_weight > 0._rt) {
+        for (auto& b : beta) { b /= total_weight; }
+    }
+
+    // The solver parameters are the most stringent ones of the group
+    Real required_precision = species_group[0]->self_fields_required_precision;
+    Real absolute_tolerance = species_group[0]->self_fields_absolute_tolerance;
+    int max_iters = species_group[0]->self_fields_max_iters;
+    int verbosity = species_group[0]->self_fields_verbosity;
+    for (auto* pc : species_group) {
+        required_precision = std::min(required_precision, pc->self_fields_required_precision);
+        absolute_tolerance = std::min(absolute_tolerance, pc->self_fields_absolute_tolerance);
+        max_iters = std::max(max_iters, pc->self_fields_max_iters);
+        verbosity = std::max(verbosity, pc->self_fields_verbosity);
     }
 
     // Compute the potential phi, by solving the Poisson equation
-    computePhi( rho, phi, beta, pc.self_fields_required_precision,
-                pc.self_fields_absolute_tolerance, pc.self_fields_max_iters,
-                pc.self_fields_verbosity );
+    computePhi( rho, phi, beta, required_precision,
+                absolute_tolerance, max_iters,
+                verbosity );
 
     // Compute the corresponding electric and magnetic field, from the potential phi
     computeE( Efield_fp, phi, beta );
@@ -385,6 +483,13 @@ WarpX::computePhi (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
     bool const is_solver_igf_on_lev0 =
         WarpX::poisson_solver_id == PoissonSolverAlgo::IntegratedGreenFunction;
 
+    // In the lab frame, the operator only depends on the grids and boundaries,
+    // and can be kept across time steps. The previous phi, which is stored in
+    // phi_fp, is also used as initial guess.
+    bool const reuse_solver = self_fields_reuse_solver &&
+        (electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrame ||
+         electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrameElectroMagnetostatic);
+
     ablastr::fields::computePhi(
         sorted_rho,
         sorted_phi,
@@ -403,7 +508,8 @@ WarpX::computePhi (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
         this->ref_ratio,
         post_phi_calculation,
         gett_new(0),
-        eb_farray_box_factory
+        eb_farray_box_factory,
+        reuse_solver ? &m_poisson_solver_cache : nullptr
     );
 
 }
@@ -0,0 +1,324 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "FiniteDifferenceSolver.H"
+
+#ifndef WARPX_DIM_RZ
+#   include "FiniteDifferenceAlgorithms/CartesianYeeAlgorithm.H"
+#   include "FiniteDifferenceAlgorithms/CartesianCKCAlgorithm.H"
+#   include "FiniteDifferenceAlgorithms/CartesianNodalAlgorithm.H"
+#endif
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXConst.H"
+#include "WarpX.H"
+
+#include <AMReX.H>
+#include <AMReX_Array4.H>
+#include <AMReX_Box.H>
+#include <AMReX_Config.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_FabArrayBase.H>
+#include <AMReX_GpuAtomic.H>
+#include <AMReX_GpuControl.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_IndexType.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_LayoutData.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Vector.H>
+
+#include <AMReX_BaseFwd.H>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+
+using namespace amrex;
+
+/**
+ * \brief Update the E and B fields over one timestep (B half-push, E push,
+ * B half-push), in a single pass over the memory
+ */
+void FiniteDifferenceSolver::EvolveEBBlocked (
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Efield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Bfield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jfield,
+    int lev, amrex::Real const dt ) {
+
+    // Select algorithm (The choice of algorithm is a runtime option,
+    // but we compile code for each algorithm, using templates)
+#ifdef WARPX_DIM_RZ
+    amrex::ignore_unused(Efield, Bfield, Jfield, lev, dt);
+    WARPX_ABORT_WITH_MESSAGE("EvolveEBBlocked: not implemented in RZ geometry");
+#else
+    if (m_grid_type == GridType::Collocated) {
+
+        EvolveEBBlockedCartesian <CartesianNodalAlgorithm> ( Efield, Bfield, Jfield, lev, dt );
+
+    } else if (m_fdtd_algo == ElectromagneticSolverAlgo::Yee) {
+
+        EvolveEBBlockedCartesian <CartesianYeeAlgorithm> ( Efield, Bfield, Jfield, lev, dt );
+
+    } else if (m_fdtd_algo == ElectromagneticSolverAlgo::CKC) {
+
+        EvolveEBBlockedCartesian <CartesianCKCAlgorithm> ( Efield, Bfield, Jfield, lev, dt );
+
+    } else {
+        WARPX_ABORT_WITH_MESSAGE("EvolveEBBlocked: Unknown algorithm");
+    }
+#endif
+}
+
+
+#ifndef WARPX_DIM_RZ
+
+template<typename T_Algo>
+void FiniteDifferenceSolver::EvolveEBBlockedCartesian (
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Efield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Bfield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jfield,
+    int lev, amrex::Real const dt ) {
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    Real constexpr c2 = PhysConst::c * PhysConst::c;
+    Real const dt_half = Real(0.5) * dt;
+
+    // Each box is cut in blocks of the tile size (fabarray.mfiter_tile_size) in each
+    // direction. On each block, B^{n+1/2} is computed on two layers of guard cells
+    // (of the width of the stencil) and E^{n+1} on one layer, so that B^{n+1} can be
+    // computed without exchanging guard cells: this requires E^{n} and B^{n} on three
+    // layers of guard cells and J on one layer. The blocks are at least as large as
+    // these three layers.
+    constexpr int zdir = AMREX_SPACEDIM-1;
+    const amrex::IntVect ng = T_Algo::GetMaxGuardCell();
+    amrex::IntVect block_size;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        block_size[idim] = std::max(amrex::FabArrayBase::mfiter_tile_size[idim], 3*ng[idim]);
+    }
+
+    std::array<amrex::IndexType,3> ixE, ixB;
+    for (int idir = 0; idir < 3; ++idir) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            (3*ng).allLE(Efield[idir]->nGrowVect()) && (3*ng).allLE(Bfield[idir]->nGrowVect()) &&
+            ng.allLE(Jfield[idir]->nGrowVect()),
+            "EvolveEBBlocked: not enough guard cells allocated for E, B or J");
+        ixE[idir] = Efield[idir]->ixType();
+        ixB[idir] = Bfield[idir]->ixType();
+    }
+
+    // Extract stencil coefficients
+    Real const * const AMREX_RESTRICT coefs_x = m_stencil_coefs_x.dataPtr();
+    auto const n_coefs_x = static_cast<int>(m_stencil_coefs_x.size());
+    Real const * const AMREX_RESTRICT coefs_y = m_stencil_coefs_y.dataPtr();
+    auto const n_coefs_y = static_cast<int>(m_stencil_coefs_y.size());
+    Real const * const AMREX_RESTRICT coefs_z = m_stencil_coefs_z.dataPtr();
+    auto const n_coefs_z = static_cast<int>(m_stencil_coefs_z.size());
+
+    // Loop through the grids. The blocks of a grid are processed slab by slab along
+    // the last dimension, and the blocks of a slab in parallel. The new fields of a
+    // slab are written back to E and B only after the next slab has been computed,
+    // since it reads the old fields of this slab.
+    for ( MFIter mfi(*Bfield[0]); mfi.isValid(); ++mfi ) {
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+        }
+        auto wt = static_cast<amrex::Real>(amrex::second());
+
+        // Extract field data for this grid
+        Array4<Real> const& Bx = Bfield[0]->array(mfi);
+        Array4<Real> const& By = Bfield[1]->array(mfi);
+        Array4<Real> const& Bz = Bfield[2]->array(mfi);
+        Array4<Real> const& Ex = Efield[0]->array(mfi);
+        Array4<Real> const& Ey = Efield[1]->array(mfi);
+        Array4<Real> const& Ez = Efield[2]->array(mfi);
+        Array4<Real const> const& jx = Jfield[0]->const_array(mfi);
+        Array4<Real const> const& jy = Jfield[1]->const_array(mfi);
+        Array4<Real const> const& jz = Jfield[2]->const_array(mfi);
+
+        const amrex::Box cell_box = amrex::enclosedCells(mfi.validbox());
+        amrex::IntVect nblocks;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            // On GPU, the blocks span the whole box in the transverse directions
+            const bool split = amrex::TilingIfNotGPU() || idim == zdir;
+            nblocks[idim] = split ? (cell_box.length(idim) + block_size[idim] - 1) / block_size[idim] : 1;
+        }
+        const int nslabs = nblocks[zdir];
+        int nblocks_slab = 1;
+        for (int idim = 0; idim < zdir; ++idim) { nblocks_slab *= nblocks[idim]; }
+
+        // New fields of the blocks of the current and previous slab, and the boxes on
+        // which they are written back (the nodes between two blocks belong to the upper block)
+        std::array<amrex::Vector<std::array<amrex::FArrayBox,3>>,2> Bnew, Enew;
+        std::array<amrex::Vector<std::array<amrex::Box,3>>,2> bbox, ebox;
+        for (int ib = 0; ib < 2; ++ib) {
+            Bnew[ib].resize(nblocks_slab);
+            Enew[ib].resize(nblocks_slab);
+            bbox[ib].resize(nblocks_slab);
+            ebox[ib].resize(nblocks_slab);
+        }
+
+        for (int islab = 0; islab <= nslabs; ++islab) {
+
+            if (islab < nslabs) {
+                const int ib = islab % 2;
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for schedule(dynamic) if (amrex::Gpu::notInLaunchRegion())
+#endif
+                for (int iblock = 0; iblock < nblocks_slab; ++iblock) {
+
+                    // Index of the block in each direction
+                    amrex::IntVect iv;
+                    iv[zdir] = islab;
+                    int rem = iblock;
+                    for (int idim = 0; idim < zdir; ++idim) {
+                        iv[idim] = rem % nblocks[idim];
+                        rem /= nblocks[idim];
+                    }
+
+                    amrex::Box block = cell_box;
+                    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                        const int lo = cell_box.smallEnd(idim);
+                        const int size = (nblocks[idim] > 1) ? block_size[idim] : cell_box.length(idim);
+                        block.setSmall(idim, lo + iv[idim]*size);
+                        block.setBig(idim, std::min(lo + (iv[idim]+1)*size - 1, cell_box.bigEnd(idim)));
+                    }
+
+                    for (int idir = 0; idir < 3; ++idir) {
+                        amrex::Box& bb = bbox[ib][iblock][idir];
+                        amrex::Box& eb = ebox[ib][iblock][idir];
+                        bb = amrex::convert(block, ixB[idir]);
+                        eb = amrex::convert(block, ixE[idir]);
+                        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                            if (iv[idim] < nblocks[idim]-1) {
+                                if (ixB[idir].nodeCentered(idim)) { bb.growHi(idim, -1); }
+                                if (ixE[idir].nodeCentered(idim)) { eb.growHi(idim, -1); }
+                            }
+                        }
+                        Bnew[ib][iblock][idir].resize(amrex::grow(bb, 2*ng), 1);
+                        Enew[ib][iblock][idir].resize(amrex::grow(eb, ng), 1);
+                    }
+
+                    Array4<Real> const& bx = Bnew[ib][iblock][0].array();
+                    Array4<Real> const& by = Bnew[ib][iblock][1].array();
+                    Array4<Real> const& bz = Bnew[ib][iblock][2].array();
+                    Array4<Real> const& ex = Enew[ib][iblock][0].array();
+                    Array4<Real> const& ey = Enew[ib][iblock][1].array();
+                    Array4<Real> const& ez = Enew[ib][iblock][2].array();
+
+                    // B^{n+1/2}, from B^{n} and E^{n}
+                    amrex::ParallelFor(Bnew[ib][iblock][0].box(), Bnew[ib][iblock][1].box(), Bnew[ib][iblock][2].box(),
+
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                            bx(i, j, k) = Bx(i, j, k)
+                                + dt_half * T_Algo::UpwardDz(Ey, coefs_z, n_coefs_z, i, j, k)
+                                - dt_half * T_Algo::UpwardDy(Ez, coefs_y, n_coefs_y, i, j, k);
+                        },
+
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                            by(i, j, k) = By(i, j, k)
+                                + dt_half * T_Algo::UpwardDx(Ez, coefs_x, n_coefs_x, i, j, k)
+                                - dt_half * T_Algo::UpwardDz(Ex, coefs_z, n_coefs_z, i, j, k);
+                        },
+
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                            bz(i, j, k) = Bz(i, j, k)
+                                + dt_half * T_Algo::UpwardDy(Ex, coefs_y, n_coefs_y, i, j, k)
+                                - dt_half * T_Algo::UpwardDx(Ey, coefs_x, n_coefs_x, i, j, k);
+                        }
+                    );
+
+                    // E^{n+1}, from E^{n}, B^{n+1/2} and J^{n+1/2}
+                    amrex::ParallelFor(Enew[ib][iblock][0].box(), Enew[ib][iblock][1].box(), Enew[ib][iblock][2].box(),
+
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                            ex(i, j, k) = Ex(i, j, k) + c2 * dt * (
+                                - T_Algo::DownwardDz(by, coefs_z, n_coefs_z, i, j, k)
+                                + T_Algo::DownwardDy(bz, coefs_y, n_coefs_y, i, j, k)
+                                - PhysConst::mu0 * jx(i, j, k) );
+                        },
+
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                            ey(i, j, k) = Ey(i, j, k) + c2 * dt * (
+                                - T_Algo::DownwardDx(bz, coefs_x, n_coefs_x, i, j, k)
+                                + T_Algo::DownwardDz(bx, coefs_z, n_coefs_z, i, j, k)
+                                - PhysConst::mu0 * jy(i, j, k) );
+                        },
+
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                            ez(i, j, k) = Ez(i, j, k) + c2 * dt * (
+                                - T_Algo::DownwardDy(bx, coefs_y, n_coefs_y, i, j, k)
+                                + T_Algo::DownwardDx(by, coefs_x, n_coefs_x, i, j, k)
+                                - PhysConst::mu0 * jz(i, j, k) );
+                        }
+                    );
+
+                    // B^{n+1}, from B^{n+1/2} and E^{n+1}
+                    amrex::ParallelFor(bbox[ib][iblock][0], bbox[ib][iblock][1], bbox[ib][iblock][2],
+
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                            bx(i, j, k) += dt_half * T_Algo::UpwardDz(ey, coefs_z, n_coefs_z, i, j, k)
+                                         - dt_half * T_Algo::UpwardDy(ez, coefs_y, n_coefs_y, i, j, k);
+                        },
+
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                            by(i, j, k) += dt_half * T_Algo::UpwardDx(ez, coefs_x, n_coefs_x, i, j, k)
+                                         - dt_half * T_Algo::UpwardDz(ex, coefs_z, n_coefs_z, i, j, k);
+                        },
+
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                            bz(i, j, k) += dt_half * T_Algo::UpwardDy(ex, coefs_y, n_coefs_y, i, j, k)
+                                         - dt_half * T_Algo::UpwardDx(ey, coefs_x, n_coefs_x, i, j, k);
+                        }
+                    );
+                }
+            }
+
+            // Write back the new fields of the blocks of the previous slab
+            if (islab > 0) {
+                const int ib = (islab-1) % 2;
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for schedule(dynamic) if (amrex::Gpu::notInLaunchRegion())
+#endif
+                for (int iblock = 0; iblock < nblocks_slab; ++iblock) {
+                    Array4<Real const> const& bx = Bnew[ib][iblock][0].const_array();
+                    Array4<Real const> const& by = Bnew[ib][iblock][1].const_array();
+                    Array4<Real const> const& bz = Bnew[ib][iblock][2].const_array();
+                    Array4<Real const> const& ex = Enew[ib][iblock][0].const_array();
+                    Array4<Real const> const& ey = Enew[ib][iblock][1].const_array();
+                    Array4<Real const> const& ez = Enew[ib][iblock][2].const_array();
+
+                    amrex::ParallelFor(bbox[ib][iblock][0], bbox[ib][iblock][1], bbox[ib][iblock][2],
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){ Bx(i, j, k) = bx(i, j, k); },
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){ By(i, j, k) = by(i, j, k); },
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){ Bz(i, j, k) = bz(i, j, k); }
+                    );
+                    amrex::ParallelFor(ebox[ib][iblock][0], ebox[ib][iblock][1], ebox[ib][iblock][2],
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){ Ex(i, j, k) = ex(i, j, k); },
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){ Ey(i, j, k) = ey(i, j, k); },
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){ Ez(i, j, k) = ez(i, j, k); }
+                    );
+                }
+            }
+        }
+
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+            wt = static_cast<amrex::Real>(amrex::second()) - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+        }
+    }
+}
+
+#endif // corresponds to ifndef WARPX_DIM_RZ
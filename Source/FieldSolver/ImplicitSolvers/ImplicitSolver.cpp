@@ -0,0 +1,96 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "ImplicitSolver.H"
+
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXConst.H"
+#include "WarpX.H"
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParticleReduce.H>
+
+using namespace amrex::literals;
+
+namespace
+{
+    amrex::Array<amrex::LinOpBCType,AMREX_SPACEDIM>
+    ConvertFieldBCToLinOpBC (const amrex::Vector<FieldBoundaryType>& a_fbc)
+    {
+        amrex::Array<amrex::LinOpBCType,AMREX_SPACEDIM> lbc;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            if (a_fbc[idim] == FieldBoundaryType::Periodic) {
+                lbc[idim] = amrex::LinOpBCType::Periodic;
+            }
+            else if (a_fbc[idim] == FieldBoundaryType::PEC) {
+                // The tangential components of E are zero on the boundary
+                lbc[idim] = amrex::LinOpBCType::Dirichlet;
+            }
+            else {
+                WARPX_ABORT_WITH_MESSAGE(
+                    "The preconditioner of the implicit solver only supports periodic and pec field boundaries");
+            }
+        }
+        return lbc;
+    }
+}
+
+const amrex::Geometry& ImplicitSolver::GetGeometry () const
+{
+    return m_WarpX->Geom(0);
+}
+
+const amrex::BoxArray& ImplicitSolver::GetBoxArray () const
+{
+    return m_WarpX->boxArray(0);
+}
+
+const amrex::DistributionMapping& ImplicitSolver::GetDistributionMapping () const
+{
+    return m_WarpX->DistributionMap(0);
+}
+
+amrex::Array<amrex::LinOpBCType,AMREX_SPACEDIM> ImplicitSolver::GetLinOpBCLo () const
+{
+    return ConvertFieldBCToLinOpBC(WarpX::field_boundary_lo);
+}
+
+amrex::Array<amrex::LinOpBCType,AMREX_SPACEDIM> ImplicitSolver::GetLinOpBCHi () const
+{
+    return ConvertFieldBCToLinOpBC(WarpX::field_boundary_hi);
+}
+
+amrex::Real ImplicitSolver::GetMeanPlasmaFrequencySquared () const
+{
+    using PType = typename WarpXParticleContainer::SuperParticleType;
+
+    amrex::Real wp2_volume = 0.0_rt;
+    auto& mypc = m_WarpX->GetPartContainer();
+    for (int i_s = 0; i_s < mypc.nSpecies(); ++i_s) {
+        auto& pc = mypc.GetParticleContainer(i_s);
+        const amrex::ParticleReal q = pc.getCharge();
+        const amrex::ParticleReal m = pc.getMass();
+        // photons and neutral species do not contribute
+        if (q == 0._prt || m == 0._prt) { continue; }
+
+        const amrex::Real w_tot = amrex::ReduceSum(pc,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+            {
+                return static_cast<amrex::Real>(p.rdata(PIdx::w));
+            });
+        wp2_volume += w_tot*q*q/(PhysConst::ep0*m);
+    }
+    amrex::ParallelDescriptor::ReduceRealSum(wp2_volume);
+
+    const amrex::Geometry& geom = GetGeometry();
+    amrex::Real volume = 1.0_rt;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) { volume *= geom.ProbLength(idim); }
+
+    return wp2_volume/volume;
+}
@@ -42,8 +42,30 @@
 #include <array>
 #include <memory>
 #include <ostream>
+#include <string>
 #include <vector>
 
+namespace
+{
+    // Names of the transient particle attributes that hold the
+    // position and momentum at the start of the implicit step
+    std::vector<std::string> ImplicitStepStartComps ()
+    {
+        std::vector<std::string> names;
+#if (AMREX_SPACEDIM >= 2)
+        names.emplace_back("x_n");
+#endif
+#if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
+        names.emplace_back("y_n");
+#endif
+        names.emplace_back("z_n");
+        names.emplace_back("ux_n");
+        names.emplace_back("uy_n");
+        names.emplace_back("uz_n");
+        return names;
+    }
+}
+
 void
 WarpX::ImplicitPreRHSOp ( amrex::Real  a_cur_time,
                           amrex::Real  a_full_dt,
@@ -108,18 +130,21 @@ WarpX::SaveParticlesAtImplicitStepStart ( )
     // The implicit advance routines require the particle velocity
     // and position values at the beginning of the step to compute the
     // time-centered position and velocity needed for the implicit stencil.
-    // Thus, we need to save this information.
+    // Thus, we need to save this information. It is only needed during
+    // the step, and is released in FinishImplicitParticleUpdate.
 
     for (auto const& pc : *mypc) {
 
+        for (auto const& name : ImplicitStepStartComps()) {
+            pc->AllocateTransientRealComp(name);
+        }
+
         for (int lev = 0; lev <= finest_level; ++lev) {
 #ifdef AMREX_USE_OMP
 #pragma omp parallel
 #endif
             {
 
-            auto particle_comps = pc->getParticleComps();
-
             for (WarpXParIter pti(*pc, lev); pti.isValid(); ++pti) {
 
                 const auto getPosition = GetParticlePosition(pti);
@@ -130,15 +155,15 @@ WarpX::SaveParticlesAtImplicitStepStart ( )
                 amrex::ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr();
 
 #if (AMREX_SPACEDIM >= 2)
-                amrex::ParticleReal* x_n = pti.GetAttribs(particle_comps["x_n"]).dataPtr();
+                amrex::ParticleReal* x_n = pc->GetTransientRealComp("x_n", pti);
 #endif
 #if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-                amrex::ParticleReal* y_n = pti.GetAttribs(particle_comps["y_n"]).dataPtr();
+                amrex::ParticleReal* y_n = pc->GetTransientRealComp("y_n", pti);
 #endif
-                amrex::ParticleReal* z_n = pti.GetAttribs(particle_comps["z_n"]).dataPtr();
-                amrex::ParticleReal* ux_n = pti.GetAttribs(particle_comps["ux_n"]).dataPtr();
-                amrex::ParticleReal* uy_n = pti.GetAttribs(particle_comps["uy_n"]).dataPtr();
-                amrex::ParticleReal* uz_n = pti.GetAttribs(particle_comps["uz_n"]).dataPtr();
+                amrex::ParticleReal* z_n = pc->GetTransientRealComp("z_n", pti);
+                amrex::ParticleReal* ux_n = pc->GetTransientRealComp("ux_n", pti);
+                amrex::ParticleReal* uy_n = pc->GetTransientRealComp("uy_n", pti);
+                amrex::ParticleReal* uz_n = pc->GetTransientRealComp("uz_n", pti);
 
                 const long np = pti.numParticles();
 
@@ -188,8 +213,6 @@ WarpX::FinishImplicitParticleUpdate ()
 #endif
             {
 
-            auto particle_comps = pc->getParticleComps();
-
             for (WarpXParIter pti(*pc, lev); pti.isValid(); ++pti) {
 
                 const auto getPosition = GetParticlePosition(pti);
@@ -201,15 +224,15 @@ WarpX::FinishImplicitParticleUpdate ()
                 amrex::ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr();
 
 #if (AMREX_SPACEDIM >= 2)
-                amrex::ParticleReal* x_n = pti.GetAttribs(particle_comps["x_n"]).dataPtr();
+                amrex::ParticleReal* x_n = pc->GetTransientRealComp("x_n", pti);
 #endif
 #if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-                amrex::ParticleReal* y_n = pti.GetAttribs(particle_comps["y_n"]).dataPtr();
+                amrex::ParticleReal* y_n = pc->GetTransientRealComp("y_n", pti);
 #endif
-                amrex::ParticleReal* z_n = pti.GetAttribs(particle_comps["z_n"]).dataPtr();
-                amrex::ParticleReal* ux_n = pti.GetAttribs(particle_comps["ux_n"]).dataPtr();
-                amrex::ParticleReal* uy_n = pti.GetAttribs(particle_comps["uy_n"]).dataPtr();
-                amrex::ParticleReal* uz_n = pti.GetAttribs(particle_comps["uz_n"]).dataPtr();
+                amrex::ParticleReal* z_n = pc->GetTransientRealComp("z_n", pti);
+                amrex::ParticleReal* ux_n = pc->GetTransientRealComp("ux_n", pti);
+                amrex::ParticleReal* uy_n = pc->GetTransientRealComp("uy_n", pti);
+                amrex::ParticleReal* uz_n = pc->GetTransientRealComp("uz_n", pti);
 
                 const long np = pti.numParticles();
 
@@ -238,6 +261,12 @@ WarpX::FinishImplicitParticleUpdate ()
 
         }
 
+        // The values at the start of the step are no longer needed
+        amrex::Gpu::streamSynchronize();
+        for (auto const& name : ImplicitStepStartComps()) {
+            pc->ReleaseTransientRealComp(name);
+        }
+
     }
 
 }
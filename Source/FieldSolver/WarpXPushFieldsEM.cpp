@@ -21,6 +21,7 @@
 #   endif
 #endif
 #include "Python/callbacks.H"
+#include "Utils/TelemetryTimers.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
@@ -28,6 +29,8 @@
 #include "WarpXPushFieldsEM_K.H"
 #include "WarpX_FDTD.H"
 
+#include <ablastr/utils/Communication.H>
+
 #include <AMReX.H>
 #ifdef AMREX_USE_SENSEI_INSITU
 #   include <AMReX_AmrMeshInSituBridge.H>
@@ -650,6 +653,7 @@ WarpX::PSATDScaleAverageFields (const amrex::Real scale_factor)
 void
 WarpX::PushPSATD ()
 {
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::FieldSolve);
 #ifndef WARPX_USE_FFT
     WARPX_ABORT_WITH_MESSAGE(
         "PushFieldsEM: PSATD solver selected but not built");
@@ -808,6 +812,7 @@ void
 WarpX::EvolveB (int lev, amrex::Real a_dt, DtType a_dt_type)
 {
     WARPX_PROFILE("WarpX::EvolveB()");
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::FieldSolve);
     EvolveB(lev, PatchType::fine, a_dt, a_dt_type);
     if (lev > 0)
     {
@@ -861,6 +866,7 @@ void
 WarpX::EvolveE (int lev, amrex::Real a_dt)
 {
     WARPX_PROFILE("WarpX::EvolveE()");
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::FieldSolve);
     EvolveE(lev, PatchType::fine, a_dt);
     if (lev > 0)
     {
@@ -921,6 +927,32 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
 }
 
 
+void
+WarpX::EvolveEBBlocked (amrex::Real a_dt)
+{
+    WARPX_PROFILE("WarpX::EvolveEBBlocked()");
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::FieldSolve);
+
+    // The callbacks between the B and E pushes cannot be executed
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        !IsPythonCallbackInstalled("afterBpush") && !IsPythonCallbackInstalled("afterEpush"),
+        "The afterBpush and afterEpush callbacks cannot be used with algo.fdtd_temporal_blocking");
+
+    // Only one level (checked in ReadParameters)
+    const int lev = 0;
+
+    // Instead of exchanging the guard cells of B and E after each push, exchange
+    // enough guard cells before the blocked push for them to be recomputed
+    FillBoundaryE(lev, guard_cells.ng_FieldSolverBlocked, WarpX::sync_nodal_points);
+    FillBoundaryB(lev, guard_cells.ng_FieldSolverBlocked, WarpX::sync_nodal_points);
+    for (int idim = 0; idim < 3; ++idim) {
+        ablastr::utils::communication::FillBoundary(*current_fp[lev][idim], guard_cells.ng_FieldSolver,
+                                                    WarpX::do_single_precision_comms, Geom(lev).periodicity());
+    }
+
+    m_fdtd_solver_fp[lev]->EvolveEBBlocked(Efield_fp[lev], Bfield_fp[lev], current_fp[lev], lev, a_dt);
+}
+
 void
 WarpX::EvolveF (amrex::Real a_dt, DtType a_dt_type)
 {
@@ -947,6 +979,7 @@ WarpX::EvolveF (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_typ
     if (!do_dive_cleaning) { return; }
 
     WARPX_PROFILE("WarpX::EvolveF()");
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::FieldSolve);
 
     const int rhocomp = (a_dt_type == DtType::FirstHalf) ? 0 : 1;
 
@@ -1001,6 +1034,7 @@ WarpX::EvolveG (int lev, PatchType patch_type, amrex::Real a_dt, DtType /*a_dt_t
     if (!do_divb_cleaning) { return; }
 
     WARPX_PROFILE("WarpX::EvolveG()");
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::FieldSolve);
 
     // Evolve G field in regular cells
     if (patch_type == PatchType::fine)
@@ -1027,6 +1061,7 @@ void
 WarpX::MacroscopicEvolveE (int lev, amrex::Real a_dt) {
 
     WARPX_PROFILE("WarpX::MacroscopicEvolveE()");
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::FieldSolve);
 
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
         lev == 0,
@@ -9,6 +9,7 @@
 #include "Evolve/WarpXDtType.H"
 #include "FieldSolver/FiniteDifferenceSolver/HybridPICModel/HybridPICModel.H"
 #include "Particles/MultiParticleContainer.H"
+#include "Utils/TelemetryTimers.H"
 #include "Utils/TextMsg.H"
 #include "Fluids/MultiFluidContainer.H"
 #include "Fluids/WarpXFluidContainer.H"
@@ -20,6 +21,7 @@ using namespace amrex;
 void WarpX::HybridPICEvolveFields ()
 {
     WARPX_PROFILE("WarpX::HybridPICEvolveFields()");
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::FieldSolve);
 
     // The below deposition is hard coded for a single level simulation
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
@@ -16,6 +16,9 @@
 #include "Utils/WarpXUtil.H"
 #include "Utils/SpeciesUtils.H"
 
+#include <AMReX_FArrayBox.H>
+#include <AMReX_GpuElixir.H>
+
 using namespace ablastr::utils::communication;
 using namespace amrex;
 
@@ -434,91 +437,94 @@ void WarpXFluidContainer::AdvectivePush_Muscl (int lev)
     const amrex::Real dt_over_dz_half = 0.5_rt*(dt/dx[0]);
 #endif
 
-    const amrex::BoxArray ba = N[lev]->boxArray();
-
-    // Temporary Half-step values
-#if defined(WARPX_DIM_3D)
-    amrex::MultiFab tmp_U_minus_x( amrex::convert(ba, IntVect(0,1,1)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_x( amrex::convert(ba, IntVect(0,1,1)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_minus_y( amrex::convert(ba, IntVect(1,0,1)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_y( amrex::convert(ba, IntVect(1,0,1)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_minus_z( amrex::convert(ba, IntVect(1,1,0)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_z( amrex::convert(ba, IntVect(1,1,0)), N[lev]->DistributionMap(), 4, 1);
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-    amrex::MultiFab tmp_U_minus_x( amrex::convert(ba, IntVect(0,1)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_x( amrex::convert(ba, IntVect(0,1)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_minus_z( amrex::convert(ba, IntVect(1,0)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_z( amrex::convert(ba, IntVect(1,0)), N[lev]->DistributionMap(), 4, 1);
-#else
-    amrex::MultiFab tmp_U_minus_z( amrex::convert(ba, IntVect(0)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_z( amrex::convert(ba, IntVect(0)), N[lev]->DistributionMap(), 4, 1);
-#endif
+    // N and NU are updated in place, while the reconstruction on a tile reads N and NU
+    // in the neighboring tiles: it thus reads a copy of their values at the start of
+    // the step, Q_old = [N, NUx, NUy, NUz], filled in a first pass over the boxes
+    amrex::MultiFab Q_old(N[lev]->boxArray(), N[lev]->DistributionMap(), 4, N[lev]->nGrowVect());
+    amrex::MultiFab::Copy(Q_old, *N[lev], 0, 0, 1, N[lev]->nGrowVect());
+    for (int idir = 0; idir < 3; ++idir) {
+        amrex::MultiFab::Copy(Q_old, *NU[lev][idir], 0, idir+1, 1, N[lev]->nGrowVect());
+    }
 
-    // Fill edge values of N and U at the half timestep for MUSCL
+    // The edge values are reconstructed and the fluxes are applied in one pass per
+    // tile, so that the edge values stay in cache
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for (MFIter mfi(*N[lev], TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
-
-        // Loop over a box with one extra gridpoint in the ghost region to avoid
-        // an extra MPI communication between the edge value computation loop and
-        // the flux calculation loop
-        const amrex::Box tile_box = [&](){
-            auto tt = mfi.growntilebox(1);
+        const amrex::Box valid_box = mfi.validbox();
+        amrex::Box const tile_box = mfi.tilebox(N[lev]->ixType().toIntVect());
+
+        amrex::Array4<Real> const &N_new = N[lev]->array(mfi);
+        amrex::Array4<Real> const &NUx_new = NU[lev][0]->array(mfi);
+        amrex::Array4<Real> const &NUy_new = NU[lev][1]->array(mfi);
+        amrex::Array4<Real> const &NUz_new = NU[lev][2]->array(mfi);
+
+        amrex::Array4<Real> const Q_old_arr = Q_old.array(mfi);
+        amrex::Array4<Real> const N_arr(Q_old_arr, 0, 1);
+        amrex::Array4<Real> const NUx_arr(Q_old_arr, 1, 1);
+        amrex::Array4<Real> const NUy_arr(Q_old_arr, 2, 1);
+        amrex::Array4<Real> const NUz_arr(Q_old_arr, 3, 1);
+
+        // Loop over a box with one extra gridpoint around the tile, so that
+        // all the edge values needed by the flux calculation on the tile
+        // are reconstructed
+        const amrex::Box recon_box = [&](){
+            auto tt = amrex::grow(tile_box, 1);
 #if defined (WARPX_DIM_RZ)
             // Limit the grown box for RZ at r = 0, r_max
             const int idir = 0;
-            const int n_cell = -1;
-            tt.growLo(idir, n_cell);
-            tt.growHi(idir, n_cell);
+            if (tile_box.smallEnd(idir) == valid_box.smallEnd(idir)) { tt.growLo(idir, -1); }
+            if (tile_box.bigEnd(idir) == valid_box.bigEnd(idir)) { tt.growHi(idir, -1); }
 #endif
-           return tt;
+            return tt;
         }();
 
-        amrex::Array4<Real> const &N_arr = N[lev]->array(mfi);
-        amrex::Array4<Real> const &NUx_arr = NU[lev][0]->array(mfi);
-        amrex::Array4<Real> const &NUy_arr = NU[lev][1]->array(mfi);
-        amrex::Array4<Real> const &NUz_arr = NU[lev][2]->array(mfi);
-
         // Boxes are computed to avoid going out of bounds.
-        // Grow the entire domain
-        amrex::Box box = mfi.validbox();
-        box.grow(1);
+        const amrex::Box box = amrex::grow(tile_box, 1);
 #if defined(WARPX_DIM_3D)
-        amrex::Box const box_x = amrex::convert( box, tmp_U_minus_x.ixType() );
-        amrex::Box const box_y = amrex::convert( box, tmp_U_minus_y.ixType() );
-        amrex::Box const box_z = amrex::convert( box, tmp_U_minus_z.ixType() );
+        amrex::Box const box_x = amrex::convert( box, IntVect(0,1,1) );
+        amrex::Box const box_y = amrex::convert( box, IntVect(1,0,1) );
+        amrex::Box const box_z = amrex::convert( box, IntVect(1,1,0) );
 #elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-        amrex::Box const box_x = amrex::convert( box, tmp_U_minus_x.ixType() );
-        amrex::Box const box_z = amrex::convert( box, tmp_U_minus_z.ixType() );
+        amrex::Box const box_x = amrex::convert( box, IntVect(0,1) );
+        amrex::Box const box_z = amrex::convert( box, IntVect(1,0) );
 #else
-        amrex::Box const box_z = amrex::convert( box, tmp_U_minus_z.ixType() );
+        amrex::Box const box_z = amrex::convert( box, IntVect(0) );
 #endif
 
-        //N and NU are always defined at the nodes, the tmp_Q_* are defined
+        //N and NU are always defined at the nodes, the U_* are defined
         //in between the nodes (i.e. on the staggered Yee grid) and store the
         //values of N and U at these points.
         //(i.e. the 4 components correspond to N + the 3 components of U)
-        // Extract the temporary arrays for edge values
+        // Tile-local temporary arrays for edge values, protected by Elixir on GPU
+#if defined(WARPX_DIM_3D) || defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+        amrex::FArrayBox U_minus_x_fab(box_x, 4);
+        const amrex::Elixir U_minus_x_eli = U_minus_x_fab.elixir();
+        amrex::Array4<amrex::Real> const U_minus_x = U_minus_x_fab.array();
+        amrex::FArrayBox U_plus_x_fab(box_x, 4);
+        const amrex::Elixir U_plus_x_eli = U_plus_x_fab.elixir();
+        amrex::Array4<amrex::Real> const U_plus_x = U_plus_x_fab.array();
+#endif
 #if defined(WARPX_DIM_3D)
-        const amrex::Array4<amrex::Real> U_minus_x = tmp_U_minus_x.array(mfi);
-        const amrex::Array4<amrex::Real> U_plus_x = tmp_U_plus_x.array(mfi);
-        const amrex::Array4<amrex::Real> U_minus_y = tmp_U_minus_y.array(mfi);
-        const amrex::Array4<amrex::Real> U_plus_y = tmp_U_plus_y.array(mfi);
-        const amrex::Array4<amrex::Real> U_minus_z = tmp_U_minus_z.array(mfi);
-        const amrex::Array4<amrex::Real> U_plus_z = tmp_U_plus_z.array(mfi);
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-        const amrex::Array4<amrex::Real> U_minus_x = tmp_U_minus_x.array(mfi);
-        const amrex::Array4<amrex::Real> U_plus_x = tmp_U_plus_x.array(mfi);
-        const amrex::Array4<amrex::Real> U_minus_z = tmp_U_minus_z.array(mfi);
-        const amrex::Array4<amrex::Real> U_plus_z = tmp_U_plus_z.array(mfi);
-#else
-        const amrex::Array4<amrex::Real> U_minus_z = tmp_U_minus_z.array(mfi);
-        const amrex::Array4<amrex::Real> U_plus_z = tmp_U_plus_z.array(mfi);
+        amrex::FArrayBox U_minus_y_fab(box_y, 4);
+        const amrex::Elixir U_minus_y_eli = U_minus_y_fab.elixir();
+        amrex::Array4<amrex::Real> const U_minus_y = U_minus_y_fab.array();
+        amrex::FArrayBox U_plus_y_fab(box_y, 4);
+        const amrex::Elixir U_plus_y_eli = U_plus_y_fab.elixir();
+        amrex::Array4<amrex::Real> const U_plus_y = U_plus_y_fab.array();
 #endif
-
-        amrex::ParallelFor(tile_box,
+        amrex::FArrayBox U_minus_z_fab(box_z, 4);
+        const amrex::Elixir U_minus_z_eli = U_minus_z_fab.elixir();
+        amrex::Array4<amrex::Real> const U_minus_z = U_minus_z_fab.array();
+        amrex::FArrayBox U_plus_z_fab(box_z, 4);
+        const amrex::Elixir U_plus_z_eli = U_plus_z_fab.elixir();
+        amrex::Array4<amrex::Real> const U_plus_z = U_plus_z_fab.array();
+
+        // Fill edge values of N and U at the half timestep for MUSCL,
+        // from the values at the start of the step
+        amrex::ParallelFor(recon_box,
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
             {
 
@@ -735,36 +741,8 @@ void WarpXFluidContainer::AdvectivePush_Muscl (int lev)
                 }
             }
         );
-    }
-
-    // Given the values of `U_minus` and `U_plus`, compute fluxes in between nodes, and update N, NU accordingly
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
-#endif
-    for (MFIter mfi(*N[lev], TilingIfNotGPU()); mfi.isValid(); ++mfi)
-    {
-        const amrex::Box tile_box = mfi.tilebox(N[lev]->ixType().toIntVect());
-        const amrex::Array4<Real> N_arr = N[lev]->array(mfi);
-        const amrex::Array4<Real> NUx_arr = NU[lev][0]->array(mfi);
-        const amrex::Array4<Real> NUy_arr = NU[lev][1]->array(mfi);
-        const amrex::Array4<Real> NUz_arr = NU[lev][2]->array(mfi);
 
-#if defined(WARPX_DIM_3D)
-        amrex::Array4<amrex::Real> const &U_minus_x = tmp_U_minus_x.array(mfi);
-        amrex::Array4<amrex::Real> const &U_plus_x = tmp_U_plus_x.array(mfi);
-        amrex::Array4<amrex::Real> const &U_minus_y = tmp_U_minus_y.array(mfi);
-        amrex::Array4<amrex::Real> const &U_plus_y = tmp_U_plus_y.array(mfi);
-        amrex::Array4<amrex::Real> const &U_minus_z = tmp_U_minus_z.array(mfi);
-        amrex::Array4<amrex::Real> const &U_plus_z = tmp_U_plus_z.array(mfi);
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-        amrex::Array4<amrex::Real> const &U_minus_x = tmp_U_minus_x.array(mfi);
-        amrex::Array4<amrex::Real> const &U_plus_x = tmp_U_plus_x.array(mfi);
-        amrex::Array4<amrex::Real> const &U_minus_z = tmp_U_minus_z.array(mfi);
-        amrex::Array4<amrex::Real> const &U_plus_z = tmp_U_plus_z.array(mfi);
-#else
-        amrex::Array4<amrex::Real> const &U_minus_z = tmp_U_minus_z.array(mfi);
-        amrex::Array4<amrex::Real> const &U_plus_z = tmp_U_plus_z.array(mfi);
-#endif
+        // Given the values of `U_minus` and `U_plus`, compute fluxes in between nodes, and update N, NU accordingly
 
         amrex::ParallelFor(tile_box,
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
@@ -774,29 +752,29 @@ void WarpXFluidContainer::AdvectivePush_Muscl (int lev)
 #if defined(WARPX_DIM_3D)
 
                 // Update the conserved variables Q = [N, NU] from tn -> tn + dt
-                N_arr(i,j,k) = N_arr(i,j,k)  - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,0,0)
+                N_new(i,j,k) = N_new(i,j,k)  - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,0,0)
                                              - dt_over_dy*dF(U_minus_y,U_plus_y,i,j,k,clight,0,1)
                                              - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,0,2);
-                NUx_arr(i,j,k) = NUx_arr(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,1,0)
+                NUx_new(i,j,k) = NUx_new(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,1,0)
                                                 - dt_over_dy*dF(U_minus_y,U_plus_y,i,j,k,clight,1,1)
                                                 - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,1,2);
-                NUy_arr(i,j,k) = NUy_arr(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,2,0)
+                NUy_new(i,j,k) = NUy_new(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,2,0)
                                                 - dt_over_dy*dF(U_minus_y,U_plus_y,i,j,k,clight,2,1)
                                                 - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,2,2);
-                NUz_arr(i,j,k) = NUz_arr(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,3,0)
+                NUz_new(i,j,k) = NUz_new(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,3,0)
                                                 - dt_over_dy*dF(U_minus_y,U_plus_y,i,j,k,clight,3,1)
                                                 - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,3,2);
 
 #elif defined(WARPX_DIM_XZ)
 
                 // Update the conserved variables Q = [N, NU] from tn -> tn + dt
-                N_arr(i,j,k) = N_arr(i,j,k)  - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,0,0)
+                N_new(i,j,k) = N_new(i,j,k)  - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,0,0)
                                              - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,0,2);
-                NUx_arr(i,j,k) = NUx_arr(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,1,0)
+                NUx_new(i,j,k) = NUx_new(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,1,0)
                                                 - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,1,2);
-                NUy_arr(i,j,k) = NUy_arr(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,2,0)
+                NUy_new(i,j,k) = NUy_new(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,2,0)
                                                 - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,2,2);
-                NUz_arr(i,j,k) = NUz_arr(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,3,0)
+                NUz_new(i,j,k) = NUz_new(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,3,0)
                                                 - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,3,2);
 
 #elif defined(WARPX_DIM_RZ)
@@ -857,18 +835,18 @@ void WarpXFluidContainer::AdvectivePush_Muscl (int lev)
                 }
 
                 // Update the conserved variables from tn -> tn + dt
-                N_arr(i,j,k) = N_arr(i,j,k)     - (dt/Vij)*(F0_plusx - F0_minusx + dF(U_minus_z,U_plus_z,i,j,k,clight,0,2)*S_Az);
-                NUx_arr(i,j,k) = NUx_arr(i,j,k) - (dt/Vij)*(F1_plusx - F1_minusx + dF(U_minus_z,U_plus_z,i,j,k,clight,1,2)*S_Az);
-                NUy_arr(i,j,k) = NUy_arr(i,j,k) - (dt/Vij)*(F2_plusx - F2_minusx + dF(U_minus_z,U_plus_z,i,j,k,clight,2,2)*S_Az);
-                NUz_arr(i,j,k) = NUz_arr(i,j,k) - (dt/Vij)*(F3_plusx - F3_minusx + dF(U_minus_z,U_plus_z,i,j,k,clight,3,2)*S_Az);
+                N_new(i,j,k) = N_new(i,j,k)     - (dt/Vij)*(F0_plusx - F0_minusx + dF(U_minus_z,U_plus_z,i,j,k,clight,0,2)*S_Az);
+                NUx_new(i,j,k) = NUx_new(i,j,k) - (dt/Vij)*(F1_plusx - F1_minusx + dF(U_minus_z,U_plus_z,i,j,k,clight,1,2)*S_Az);
+                NUy_new(i,j,k) = NUy_new(i,j,k) - (dt/Vij)*(F2_plusx - F2_minusx + dF(U_minus_z,U_plus_z,i,j,k,clight,2,2)*S_Az);
+                NUz_new(i,j,k) = NUz_new(i,j,k) - (dt/Vij)*(F3_plusx - F3_minusx + dF(U_minus_z,U_plus_z,i,j,k,clight,3,2)*S_Az);
 
 #else
 
                 // Update the conserved variables Q = [N, NU] from tn -> tn + dt
-                N_arr(i,j,k) = N_arr(i,j,k) - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,0,2);
-                NUx_arr(i,j,k) = NUx_arr(i,j,k) - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,1,2);
-                NUy_arr(i,j,k) = NUy_arr(i,j,k) - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,2,2);
-                NUz_arr(i,j,k) = NUz_arr(i,j,k) - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,3,2);
+                N_new(i,j,k) = N_new(i,j,k) - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,0,2);
+                NUx_new(i,j,k) = NUx_new(i,j,k) - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,1,2);
+                NUy_new(i,j,k) = NUy_new(i,j,k) - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,2,2);
+                NUz_new(i,j,k) = NUz_new(i,j,k) - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,3,2);
 #endif
             }
         );
@@ -0,0 +1,467 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "ExternalFieldReader.H"
+
+#include "Utils/Algorithms/LinearInterpolation.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
+
+#include <AMReX_Array4.H>
+#include <AMReX_Box.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_IndexType.H>
+#include <AMReX_MFIter.H>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <utility>
+
+using namespace amrex::literals;
+
+amrex::RealBox
+external_field_reader::LocalPhysicalBounds (const amrex::MultiFab& mf)
+{
+    amrex::Geometry const& geom0 = WarpX::GetInstance().Geom(0);
+    const amrex::RealBox& real_box = geom0.ProbDomain();
+    const auto dx = geom0.CellSizeArray();
+
+    // Union of the index ranges of the boxes (with guard cells) owned by this rank
+    amrex::IntVect lo(INT_MAX), hi(INT_MIN);
+    bool has_boxes = false;
+    for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        const amrex::Box box = mfi.fabbox();
+        lo.min(box.smallEnd());
+        hi.max(box.bigEnd());
+        has_boxes = true;
+    }
+    if (!has_boxes) {
+        return amrex::RealBox(
+            {AMREX_D_DECL(0._rt,0._rt,0._rt)}, {AMREX_D_DECL(-1._rt,-1._rt,-1._rt)});
+    }
+
+#if defined(WARPX_DIM_RZ)
+    // The values at negative r are mirrored from positive r (see InterpolateFieldChunk)
+    const int r_lo = (lo[0] <= 0 && hi[0] >= 0) ? 0 : std::min(std::abs(lo[0]), std::abs(hi[0]));
+    const int r_hi = std::max(std::abs(lo[0]), std::abs(hi[0]));
+    lo[0] = r_lo;
+    hi[0] = r_hi;
+#endif
+
+    std::array<amrex::Real,AMREX_SPACEDIM> xlo, xhi;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        const amrex::Real shift = mf.ixType().nodeCentered(idim) ? 0._rt : 0.5_rt*dx[idim];
+        xlo[idim] = real_box.lo(idim) + lo[idim]*dx[idim] + shift;
+        xhi[idim] = real_box.lo(idim) + hi[idim]*dx[idim] + shift;
+    }
+    return amrex::RealBox(xlo, xhi);
+}
+
+#ifdef WARPX_USE_OPENPMD
+external_field_reader::FieldChunk
+external_field_reader::ReadFieldChunk (openPMD::Series& series, std::uint64_t iteration,
+                                       const std::string& F_name, const std::string& F_component,
+                                       const amrex::RealBox& bounds)
+{
+#if defined(WARPX_DIM_1D_Z)
+    amrex::ignore_unused(series, iteration, F_name, F_component, bounds);
+    WARPX_ABORT_WITH_MESSAGE("Reading fields from openPMD files is not supported in 1D");
+    return FieldChunk{};
+#elif defined(WARPX_DIM_XZ)
+    amrex::ignore_unused(series, iteration, F_name, F_component, bounds);
+    WARPX_ABORT_WITH_MESSAGE("Reading from openPMD for external fields is not known to work with XZ (see #3828)");
+    return FieldChunk{};
+#else
+    auto iseries = series.iterations[iteration];
+    auto F = iseries.meshes[F_name];
+
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(F.getAttribute("dataOrder").get<std::string>() == "C",
+                                     "Reading from files with non-C dataOrder is not implemented");
+
+    auto axisLabels = F.getAttribute("axisLabels").get<std::vector<std::string>>();
+    auto fileGeom = F.getAttribute("geometry").get<std::string>();
+
+#if defined(WARPX_DIM_3D)
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fileGeom == "cartesian", "3D can only read from files with cartesian geometry");
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(axisLabels[0] == "x" && axisLabels[1] == "y" && axisLabels[2] == "z",
+                                     "3D expects axisLabels {x, y, z}");
+#elif defined(WARPX_DIM_RZ)
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fileGeom == "thetaMode", "RZ can only read from files with 'thetaMode'  geometry");
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(axisLabels[0] == "r" && axisLabels[1] == "z",
+                                     "RZ expects axisLabels {r, z}");
+#endif
+
+    FieldChunk chunk;
+    for (const auto o : F.gridGlobalOffset()) {
+        chunk.grid_offset.push_back(static_cast<amrex::Real>(o));
+    }
+    for (const auto d : F.gridSpacing<long double>()) {
+        chunk.grid_spacing.push_back(static_cast<amrex::Real>(d));
+    }
+
+    auto FC = F[F_component];
+    const auto extent = FC.getExtent();
+
+    // No data is needed if this rank has no box
+    if (!bounds.ok()) { return chunk; }
+
+    // Axis of the record component that corresponds to each mesh axis.
+    // In RZ, the first axis of the record component is the azimuthal mode,
+    // of which only mode 0 is read (see #3829).
+#if defined(WARPX_DIM_RZ)
+    const int first_mesh_axis = 1;
+    chunk.chunk_offset[0] = 0;
+    chunk.chunk_extent[0] = 1;
+#else
+    const int first_mesh_axis = 0;
+#endif
+
+    // Range of points of the file used by the linear interpolation in the local
+    // region, with one more point on each side to be robust to round-off errors
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        const int iaxis = first_mesh_axis + idim;
+        const auto n = static_cast<int>(extent[iaxis]);
+        const auto off = chunk.grid_offset[idim];
+        const auto d = chunk.grid_spacing[idim];
+        const int ilo = static_cast<int>(std::floor((bounds.lo(idim) - off)/d)) - 1;
+        const int ihi = static_cast<int>(std::floor((bounds.hi(idim) - off)/d)) + 2;
+        chunk.chunk_offset[iaxis] = std::clamp(ilo, 0, n-1);
+        chunk.chunk_extent[iaxis] = std::clamp(ihi, 0, n-1) - chunk.chunk_offset[iaxis] + 1;
+    }
+
+    const openPMD::Offset chunk_offset = {
+        static_cast<std::uint64_t>(chunk.chunk_offset[0]),
+        static_cast<std::uint64_t>(chunk.chunk_offset[1]),
+        static_cast<std::uint64_t>(chunk.chunk_offset[2])};
+    const openPMD::Extent chunk_extent = {
+        static_cast<std::uint64_t>(chunk.chunk_extent[0]),
+        static_cast<std::uint64_t>(chunk.chunk_extent[1]),
+        static_cast<std::uint64_t>(chunk.chunk_extent[2])};
+
+    auto FC_chunk_data = FC.loadChunk<double>(chunk_offset, chunk_extent);
+    series.flush();
+
+    const size_t total_extent =
+        size_t(chunk_extent[0]) * chunk_extent[1] * chunk_extent[2];
+    chunk.data.assign(FC_chunk_data.get(), FC_chunk_data.get() + total_extent);
+    return chunk;
+#endif
+}
+#endif // WARPX_USE_OPENPMD
+
+void
+external_field_reader::InterpolateFieldChunk (const FieldChunk& chunk, amrex::MultiFab& mf)
+{
+#if defined(WARPX_DIM_1D_Z) || defined(WARPX_DIM_XZ)
+    amrex::ignore_unused(chunk, mf);
+    WARPX_ABORT_WITH_MESSAGE("Interpolating fields read from openPMD files is only supported in 3D and RZ");
+#else
+    // Get WarpX domain info
+    amrex::Geometry const& geom0 = WarpX::GetInstance().Geom(0);
+    const amrex::RealBox& real_box = geom0.ProbDomain();
+    const auto dx = geom0.CellSizeArray();
+    const amrex::IntVect nodal_flag = mf.ixType().toIntVect();
+
+    const auto offset0 = chunk.grid_offset[0];
+    const auto offset1 = chunk.grid_offset[1];
+#if defined(WARPX_DIM_3D)
+    const auto offset2 = chunk.grid_offset[2];
+#endif
+
+#if defined(WARPX_DIM_RZ)
+    const auto file_dr = chunk.grid_spacing[0];
+    const auto file_dz = chunk.grid_spacing[1];
+#elif defined(WARPX_DIM_3D)
+    const auto file_dx = chunk.grid_spacing[0];
+    const auto file_dy = chunk.grid_spacing[1];
+    const auto file_dz = chunk.grid_spacing[2];
+#endif
+
+    const auto& o = chunk.chunk_offset;
+    const auto& e = chunk.chunk_extent;
+
+    // Load data to GPU
+    amrex::Gpu::DeviceVector<double> FC_data_gpu(chunk.data.size());
+    auto *FC_data = FC_data_gpu.data();
+    amrex::Gpu::copy(amrex::Gpu::hostToDevice, chunk.data.begin(), chunk.data.end(), FC_data);
+
+    // Indices of the chunk in the record component, in the order
+    // of the Array4 (fastest varying first)
+#if defined(WARPX_DIM_RZ)
+    const amrex::Dim3 fc_begin{0, o[2], o[1]};
+    const amrex::Dim3 fc_end{e[0], o[2]+e[2], o[1]+e[1]};
+#elif defined(WARPX_DIM_3D)
+    const amrex::Dim3 fc_begin{o[2], o[1], o[0]};
+    const amrex::Dim3 fc_end{o[2]+e[2], o[1]+e[1], o[0]+e[0]};
+#endif
+
+    // Loop over boxes
+    for (amrex::MFIter mfi(mf, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const amrex::Box box = mfi.growntilebox();
+        const amrex::Box tb = mfi.tilebox(nodal_flag, mf.nGrowVect());
+        auto const& mffab = mf.array(mfi);
+
+        // Start ParallelFor
+        amrex::ParallelFor (tb,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                // i,j,k denote x,y,z indices in 3D xyz.
+                // i,j denote r,z indices in 2D rz; k is just 0
+
+                // ii is used for 2D RZ mode
+#if defined(WARPX_DIM_RZ)
+                // In 2D RZ, i denoting r can be < 0
+                // but mirrored values should be assigned.
+                // Namely, mffab(i) = FC_data[-i] when i<0.
+                const int ii = (i<0)?(-i):(i);
+#else
+                const int ii = i;
+#endif
+
+                // Physical coordinates of the grid point
+                // 0,1,2 denote x,y,z in 3D xyz.
+                // 0,1 denote r,z in 2D rz.
+                amrex::Real x0, x1;
+                if ( box.type(0)==amrex::IndexType::CellIndex::NODE )
+                     { x0 = static_cast<amrex::Real>(real_box.lo(0)) + ii*dx[0]; }
+                else { x0 = static_cast<amrex::Real>(real_box.lo(0)) + ii*dx[0] + 0.5_rt*dx[0]; }
+                if ( box.type(1)==amrex::IndexType::CellIndex::NODE )
+                     { x1 = real_box.lo(1) + j*dx[1]; }
+                else { x1 = real_box.lo(1) + j*dx[1] + 0.5_rt*dx[1]; }
+
+#if defined(WARPX_DIM_RZ)
+                // Get index of the external field array
+                int const ir = std::floor( (x0-offset0)/file_dr );
+                int const iz = std::floor( (x1-offset1)/file_dz );
+
+                // Get coordinates of external grid point
+                amrex::Real const xx0 = offset0 + ir * file_dr;
+                amrex::Real const xx1 = offset1 + iz * file_dz;
+
+#elif defined(WARPX_DIM_3D)
+                amrex::Real x2;
+                if ( box.type(2)==amrex::IndexType::CellIndex::NODE )
+                     { x2 = real_box.lo(2) + k*dx[2]; }
+                else { x2 = real_box.lo(2) + k*dx[2] + 0.5_rt*dx[2]; }
+
+                // Get index of the external field array
+                int const ix = std::floor( (x0-offset0)/file_dx );
+                int const iy = std::floor( (x1-offset1)/file_dy );
+                int const iz = std::floor( (x2-offset2)/file_dz );
+
+                // Get coordinates of external grid point
+                amrex::Real const xx0 = offset0 + ix * file_dx;
+                amrex::Real const xx1 = offset1 + iy * file_dy;
+                amrex::Real const xx2 = offset2 + iz * file_dz;
+#endif
+
+#if defined(WARPX_DIM_RZ)
+                const amrex::Array4<double> fc_array(FC_data, fc_begin, fc_end, 1);
+                const double
+                    f00 = fc_array(0, iz  , ir  ),
+                    f01 = fc_array(0, iz  , ir+1),
+                    f10 = fc_array(0, iz+1, ir  ),
+                    f11 = fc_array(0, iz+1, ir+1);
+                mffab(i,j,k) = static_cast<amrex::Real>(utils::algorithms::bilinear_interp<double>
+                    (xx0, xx0+file_dr, xx1, xx1+file_dz,
+                     f00, f01, f10, f11,
+                     x0, x1));
+#elif defined(WARPX_DIM_3D)
+                const amrex::Array4<double> fc_array(FC_data, fc_begin, fc_end, 1);
+                const double
+                    f000 = fc_array(iz  , iy  , ix  ),
+                    f001 = fc_array(iz+1, iy  , ix  ),
+                    f010 = fc_array(iz  , iy+1, ix  ),
+                    f011 = fc_array(iz+1, iy+1, ix  ),
+                    f100 = fc_array(iz  , iy  , ix+1),
+                    f101 = fc_array(iz+1, iy  , ix+1),
+                    f110 = fc_array(iz  , iy+1, ix+1),
+                    f111 = fc_array(iz+1, iy+1, ix+1);
+                mffab(i,j,k) = static_cast<amrex::Real>(utils::algorithms::trilinear_interp<double>
+                    (xx0, xx0+file_dx, xx1, xx1+file_dy, xx2, xx2+file_dz,
+                     f000, f001, f010, f011, f100, f101, f110, f111,
+                     x0, x1, x2));
+#endif
+
+            }
+
+        ); // End ParallelFor
+
+    } // End loop over boxes.
+
+    // The device copy of the chunk must outlive the kernels
+    amrex::Gpu::streamSynchronize();
+#endif
+}
+
+ExternalFieldTimeSeries::ExternalFieldTimeSeries (const std::string& path, const std::string& F_name,
+                                                  bool prefetch)
+    : m_F_name{F_name}, m_do_prefetch{prefetch}
+{
+#if defined(WARPX_DIM_RZ)
+    m_components = {"r", "t", "z"};
+#else
+    m_components = {"x", "y", "z"};
+#endif
+
+#if defined(WARPX_USE_OPENPMD) && !defined(WARPX_DIM_1D_Z) && !defined(WARPX_DIM_XZ)
+    // Each rank only reads its own part of the data, so the series is not opened collectively
+    m_series = std::make_unique<openPMD::Series>(path, openPMD::Access::READ_ONLY);
+
+    std::vector<std::pair<amrex::Real,std::uint64_t>> time_and_iteration;
+    for (auto& [index, iteration] : m_series->iterations) {
+        const auto t = static_cast<amrex::Real>(iteration.time<double>()*iteration.timeUnitSI());
+        time_and_iteration.emplace_back(t, index);
+    }
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!time_and_iteration.empty(),
+        "The openPMD series " + path + " does not contain any iteration");
+    std::sort(time_and_iteration.begin(), time_and_iteration.end());
+    for (const auto& [t, index] : time_and_iteration) {
+        m_times.push_back(t);
+        m_iterations.push_back(index);
+    }
+#elif defined(WARPX_DIM_1D_Z)
+    amrex::ignore_unused(path);
+    WARPX_ABORT_WITH_MESSAGE("Reading fields from openPMD files is not supported in 1D");
+#elif defined(WARPX_DIM_XZ)
+    amrex::ignore_unused(path);
+    WARPX_ABORT_WITH_MESSAGE("Reading from openPMD for external fields is not known to work with XZ (see #3828)");
+#else
+    amrex::ignore_unused(path);
+    WARPX_ABORT_WITH_MESSAGE("OpenPMD field reading requires OpenPMD support to be enabled");
+#endif
+}
+
+ExternalFieldTimeSeries::~ExternalFieldTimeSeries ()
+{
+    CancelPrefetch();
+}
+
+void
+ExternalFieldTimeSeries::Update (amrex::Real time, const std::array<amrex::MultiFab*,3>& field)
+{
+    WARPX_PROFILE("ExternalFieldTimeSeries::Update()");
+
+    // (Re)allocate the snapshots if the grids of the field changed, e.g., after a regrid
+    bool grids_changed = false;
+    for (int icomp = 0; icomp < 3; ++icomp) {
+        const amrex::MultiFab& mf = *field[icomp];
+        for (auto& snapshot : m_snapshot) {
+            if (!snapshot[icomp].isDefined() ||
+                snapshot[icomp].boxArray() != mf.boxArray() ||
+                snapshot[icomp].DistributionMap() != mf.DistributionMap()) {
+                snapshot[icomp].define(mf.boxArray(), mf.DistributionMap(), 1, mf.nGrowVect());
+                grids_changed = true;
+            }
+        }
+    }
+    if (grids_changed) {
+        m_snapshot_index = {-1, -1};
+        CancelPrefetch();
+    }
+    else if (time == m_last_time) {
+        return;
+    }
+    m_last_time = time;
+
+    // Iterations that bracket the current time
+    const int n = static_cast<int>(m_times.size());
+    int i0 = 0, i1 = 0;
+    if (n > 1) {
+        const auto upper = std::upper_bound(m_times.begin(), m_times.end(), time) - m_times.begin();
+        i1 = std::clamp(static_cast<int>(upper), 1, n-1);
+        i0 = i1 - 1;
+    }
+    LoadSnapshot(i0, i1);
+    LoadSnapshot(i1, i0);
+
+    // Start reading the iteration that is needed next
+    if (m_do_prefetch && i1+1 < n && m_prefetch_index != i1+1) {
+        StartPrefetch(i1+1);
+    }
+
+    // Linear interpolation in time, constant outside of the time range of the series
+    amrex::Real w1 = 0._rt;
+    if (m_times[i1] > m_times[i0]) {
+        w1 = std::clamp((time - m_times[i0])/(m_times[i1] - m_times[i0]), 0._rt, 1._rt);
+    }
+    const int s0 = (m_snapshot_index[0] == i0) ? 0 : 1;
+    const int s1 = (m_snapshot_index[0] == i1) ? 0 : 1;
+    for (int icomp = 0; icomp < 3; ++icomp) {
+        amrex::MultiFab::LinComb(*field[icomp],
+                                 1._rt - w1, m_snapshot[s0][icomp], 0,
+                                 w1, m_snapshot[s1][icomp], 0,
+                                 0, 1, field[icomp]->nGrowVect());
+    }
+}
+
+std::array<external_field_reader::FieldChunk,3>
+ExternalFieldTimeSeries::ReadSnapshot (int index, const std::array<amrex::RealBox,3>& bounds)
+{
+    std::array<external_field_reader::FieldChunk,3> chunks;
+#ifdef WARPX_USE_OPENPMD
+    for (int icomp = 0; icomp < 3; ++icomp) {
+        chunks[icomp] = external_field_reader::ReadFieldChunk(
+            *m_series, m_iterations[index], m_F_name, m_components[icomp], bounds[icomp]);
+    }
+#else
+    amrex::ignore_unused(index, bounds);
+#endif
+    return chunks;
+}
+
+void
+ExternalFieldTimeSeries::LoadSnapshot (int index, int keep)
+{
+    if (m_snapshot_index[0] == index || m_snapshot_index[1] == index) { return; }
+
+    std::array<external_field_reader::FieldChunk,3> chunks;
+    if (m_prefetch_index == index) {
+        chunks = m_prefetch.get();
+        m_prefetch_index = -1;
+    } else {
+        // The series must not be read by two threads at the same time
+        CancelPrefetch();
+        chunks = ReadSnapshot(index, LocalBounds());
+    }
+
+    const int slot = (m_snapshot_index[0] == keep) ? 1 : 0;
+    for (int icomp = 0; icomp < 3; ++icomp) {
+        external_field_reader::InterpolateFieldChunk(chunks[icomp], m_snapshot[slot][icomp]);
+    }
+    m_snapshot_index[slot] = index;
+}
+
+std::array<amrex::RealBox,3>
+ExternalFieldTimeSeries::LocalBounds () const
+{
+    std::array<amrex::RealBox,3> bounds;
+    for (int icomp = 0; icomp < 3; ++icomp) {
+        bounds[icomp] = external_field_reader::LocalPhysicalBounds(m_snapshot[0][icomp]);
+    }
+    return bounds;
+}
+
+void
+ExternalFieldTimeSeries::StartPrefetch (int index)
+{
+    CancelPrefetch();
+    // The region to read is computed here, since the grids must not be accessed by the reading thread
+    m_prefetch = std::async(std::launch::async,
+        [this, index, bounds = LocalBounds()] () { return ReadSnapshot(index, bounds); });
+    m_prefetch_index = index;
+}
+
+void
+ExternalFieldTimeSeries::CancelPrefetch ()
+{
+    if (m_prefetch.valid()) { m_prefetch.wait(); }
+    m_prefetch = {};
+    m_prefetch_index = -1;
+}
@@ -9,15 +9,25 @@
 
 #include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
+#include "Utils/WarpXConst.H"
 
+#include <AMReX_Arena.H>
 #include <AMReX_BLassert.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_GpuDevice.H>
 #include <AMReX_ParmParse.H>
 
 #include <algorithm>
 #include <cctype>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <set>
+#include <sstream>
 #include <vector>
 
 using namespace amrex;
+using namespace amrex::literals;
 
 void InjectorDensity::clear ()
 {
@@ -32,6 +42,11 @@ void InjectorDensity::clear ()
         object.predefined.clear();
         break;
     }
+    case Type::table:
+    {
+        object.table.clear();
+        break;
+    }
     default:
         return;
     }
@@ -69,3 +84,177 @@ InjectorDensityPredefined::InjectorDensityPredefined (
 void InjectorDensityPredefined::clear ()
 {
 }
+
+InjectorDensityTable::InjectorDensityTable (amrex::Parser const& a_parser,
+                                            std::string const& a_species_name,
+                                            std::string const& a_source_name)
+    : m_parser{a_parser.compile<3>()}
+{
+    const ParmParse pp_species_name(a_species_name);
+
+    std::string table_type;
+    utils::parser::get(pp_species_name, a_source_name, "density_table", table_type);
+    std::transform(table_type.begin(), table_type.end(), table_type.begin(), ::tolower);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(table_type == "z" || table_type == "separable",
+        a_species_name + ".density_table must be either z or separable");
+
+#if defined(WARPX_DIM_1D_Z)
+    const bool do_transverse = false;
+#else
+    const bool do_transverse = (table_type == "separable");
+#endif
+    if (!do_transverse) {
+        const std::set<std::string> symbols = a_parser.symbols();
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            symbols.count("x") == 0 && symbols.count("y") == 0,
+            a_species_name + ".density_table = z requires a density_function "
+            "that only depends on z (use density_table = separable otherwise)");
+    }
+
+    // Longitudinal extent of the table: the injection range of the species,
+    // unless specified explicitly
+    m_zmin = std::numeric_limits<amrex::Real>::lowest();
+    m_zmax = std::numeric_limits<amrex::Real>::max();
+    utils::parser::queryWithParser(pp_species_name, a_source_name, "zmin", m_zmin);
+    utils::parser::queryWithParser(pp_species_name, a_source_name, "zmax", m_zmax);
+    utils::parser::queryWithParser(pp_species_name, a_source_name, "density_table_zmin", m_zmin);
+    utils::parser::queryWithParser(pp_species_name, a_source_name, "density_table_zmax", m_zmax);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_zmin > std::numeric_limits<amrex::Real>::lowest() &&
+        m_zmax < std::numeric_limits<amrex::Real>::max() && m_zmax > m_zmin,
+        a_species_name + ".density_table requires a finite z range: "
+        "set zmin and zmax (or density_table_zmin and density_table_zmax)");
+
+    m_nz = 4096;
+    utils::parser::queryWithParser(pp_species_name, a_source_name, "density_table_nz", m_nz);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_nz >= 2,
+        a_species_name + ".density_table_nz must be at least 2");
+    m_dz = (m_zmax - m_zmin)/static_cast<amrex::Real>(m_nz - 1);
+
+    amrex::Real tolerance = 1.e-3_rt;
+    utils::parser::queryWithParser(pp_species_name, a_source_name, "density_table_tolerance", tolerance);
+
+    // The profiles are tabulated on the host, then copied to the device
+    auto const host_parser = a_parser.compileHost<3>();
+
+    // Reference transverse position at which the longitudinal table is computed
+    amrex::Real x_ref = 0._rt, y_ref = 0._rt;
+    m_nx = 1;
+    m_ny = 1;
+    if (do_transverse) {
+        // In RZ, the transverse table is along r
+        const amrex::Geometry& geom = amrex::DefaultGeometry();
+        amrex::Real xmin = geom.ProbLo(0), xmax = geom.ProbHi(0);
+        utils::parser::queryWithParser(pp_species_name, a_source_name, "xmin", xmin);
+        utils::parser::queryWithParser(pp_species_name, a_source_name, "xmax", xmax);
+        m_xmin = std::max(xmin, geom.ProbLo(0));
+        m_nx = 256;
+        utils::parser::queryWithParser(pp_species_name, a_source_name, "density_table_nx", m_nx);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_nx >= 2,
+            a_species_name + ".density_table_nx must be at least 2");
+        m_dx = (std::min(xmax, geom.ProbHi(0)) - m_xmin)/static_cast<amrex::Real>(m_nx - 1);
+        x_ref = m_xmin + 0.5_rt*static_cast<amrex::Real>(m_nx - 1)*m_dx;
+#if defined(WARPX_DIM_3D)
+        amrex::Real ymin = geom.ProbLo(1), ymax = geom.ProbHi(1);
+        utils::parser::queryWithParser(pp_species_name, a_source_name, "ymin", ymin);
+        utils::parser::queryWithParser(pp_species_name, a_source_name, "ymax", ymax);
+        m_ymin = std::max(ymin, geom.ProbLo(1));
+        m_ny = 256;
+        utils::parser::queryWithParser(pp_species_name, a_source_name, "density_table_ny", m_ny);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_ny >= 2,
+            a_species_name + ".density_table_ny must be at least 2");
+        m_dy = (std::min(ymax, geom.ProbHi(1)) - m_ymin)/static_cast<amrex::Real>(m_ny - 1);
+        y_ref = m_ymin + 0.5_rt*static_cast<amrex::Real>(m_ny - 1)*m_dy;
+#endif
+    }
+
+    std::vector<amrex::Real> z_table(m_nz);
+    int iz_ref = 0;
+    for (int i = 0; i < m_nz; ++i) {
+        z_table[i] = host_parser(x_ref, y_ref, m_zmin + static_cast<amrex::Real>(i)*m_dz);
+        if (std::abs(z_table[i]) > std::abs(z_table[iz_ref])) { iz_ref = i; }
+    }
+
+    // For separable profiles, n(x,y,z) = n(x,y,z_ref) * n(x_ref,y_ref,z) / n(x_ref,y_ref,z_ref)
+    std::vector<amrex::Real> t_table;
+    if (do_transverse) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(z_table[iz_ref] != 0._rt,
+            a_species_name + ".density_table = separable requires a density_function "
+            "that does not vanish everywhere at the center of the transverse range");
+        const amrex::Real z_ref = m_zmin + static_cast<amrex::Real>(iz_ref)*m_dz;
+        const amrex::Real inv_n_ref = 1._rt/z_table[iz_ref];
+        t_table.resize(static_cast<std::size_t>(m_nx)*m_ny);
+        for (int j = 0; j < m_ny; ++j) {
+            for (int i = 0; i < m_nx; ++i) {
+                t_table[i+j*m_nx] = inv_n_ref*host_parser(
+                    m_xmin + static_cast<amrex::Real>(i)*m_dx,
+                    m_ymin + static_cast<amrex::Real>(j)*m_dy, z_ref);
+            }
+        }
+    }
+
+    // Check the accuracy of the table against the parser, in between table points
+    // (in RZ, at random angles, since the table is along r)
+    constexpr int nsamples = 1000;
+#if defined(WARPX_DIM_RZ)
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<amrex::Real> theta_dist(0._rt, 2._rt*MathConst::pi);
+#endif
+    amrex::Real max_error = 0._rt, max_density = 0._rt;
+    for (int k = 0; k < nsamples; ++k) {
+        // quasi-random (golden ratio) sequences for the transverse positions
+        const amrex::Real z = m_zmin + (static_cast<amrex::Real>(k)+0.5_rt)*(m_zmax-m_zmin)/nsamples;
+        amrex::Real x = x_ref, y = y_ref;
+        if (do_transverse) {
+            double ipart;
+            x = m_xmin + static_cast<amrex::Real>(std::modf(0.6180339887*k, &ipart)*(m_nx-1))*m_dx;
+            if (m_ny > 1) {
+                y = m_ymin + static_cast<amrex::Real>(std::modf(0.7548776662*k, &ipart)*(m_ny-1))*m_dy;
+            }
+#if defined(WARPX_DIM_RZ)
+            const amrex::Real r = x;
+            const amrex::Real theta = theta_dist(rng);
+            x = r*std::cos(theta);
+            y = r*std::sin(theta);
+#endif
+        }
+        amrex::Real n_table = interpolate1D(z_table.data(), m_nz, m_zmin, m_dz, z);
+        if (do_transverse) {
+            n_table *= transverseProfile(t_table.data(), x, y);
+        }
+        const amrex::Real n_parser = host_parser(x, y, z);
+        max_error = std::max(max_error, std::abs(n_table - n_parser));
+        max_density = std::max(max_density, std::abs(n_parser));
+    }
+    if (max_density > 0._rt) {
+        std::stringstream ss;
+        ss << a_species_name << ".density_table: the relative error of the tabulated "
+           << "density profile (" << max_error/max_density << ") exceeds "
+           << a_species_name << ".density_table_tolerance (" << tolerance << "). "
+           << "Increase the number of table points, or use density_table = none.";
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(max_error <= tolerance*max_density, ss.str());
+    }
+
+    m_z_table = static_cast<amrex::Real*>(
+        amrex::The_Arena()->alloc(z_table.size()*sizeof(amrex::Real)));
+    amrex::Gpu::htod_memcpy(m_z_table, z_table.data(), z_table.size()*sizeof(amrex::Real));
+    if (do_transverse) {
+        m_t_table = static_cast<amrex::Real*>(
+            amrex::The_Arena()->alloc(t_table.size()*sizeof(amrex::Real)));
+        amrex::Gpu::htod_memcpy(m_t_table, t_table.data(), t_table.size()*sizeof(amrex::Real));
+    }
+}
+
+// Note that we are not allowed to have non-trivial destructor.
+// So we rely on clear() to free the tables.
+void InjectorDensityTable::clear ()
+{
+    if (m_z_table) {
+        amrex::The_Arena()->free(m_z_table);
+        m_z_table = nullptr;
+    }
+    if (m_t_table) {
+        amrex::The_Arena()->free(m_t_table);
+        m_t_table = nullptr;
+    }
+}
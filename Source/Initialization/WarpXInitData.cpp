@@ -22,8 +22,8 @@
 #include "Filter/BilinearFilter.H"
 #include "Filter/NCIGodfreyFilter.H"
 #include "Initialization/ExternalField.H"
+#include "Initialization/ExternalFieldReader.H"
 #include "Particles/MultiParticleContainer.H"
-#include "Utils/Algorithms/LinearInterpolation.H"
 #include "Utils/Logo/GetLogo.H"
 #include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
@@ -581,6 +581,9 @@ WarpX::InitData ()
     }
 
     if (restart_chkfile.empty() || write_diagnostics_on_restart) {
+        // Derived fields (e.g. rho) are computed once for all the diagnostics below
+        const DerivedFieldCache::Scope derived_field_cache_scope(m_derived_field_cache);
+
         // Write full diagnostics before the first iteration.
         multi_diags->FilterComputePackFlush(istep[0] - 1);
 
@@ -652,20 +655,6 @@ WarpX::InitFromScratch ()
         m_implicit_solver->GetParticleSolverParams( max_particle_its_in_implicit_scheme,
                                                     particle_tol_in_implicit_scheme );
 
-        // Add space to save the positions and velocities at the start of the time steps
-        for (auto const& pc : *mypc) {
-#if (AMREX_SPACEDIM >= 2)
-            pc->AddRealComp("x_n");
-#endif
-#if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-            pc->AddRealComp("y_n");
-#endif
-            pc->AddRealComp("z_n");
-            pc->AddRealComp("ux_n");
-            pc->AddRealComp("uy_n");
-            pc->AddRealComp("uz_n");
-        }
-
     }
 
     mypc->AllocData();
@@ -1412,37 +1401,53 @@ WarpX::LoadExternalFields (int const lev)
 
     // External particle fields
 
-    if (mypc->m_B_ext_particle_s == "read_from_file") {
-        std::string external_fields_path;
-        const amrex::ParmParse pp_particles("particles");
-        pp_particles.get("read_fields_from_path", external_fields_path );
-#if defined(WARPX_DIM_RZ)
-        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(n_rz_azimuthal_modes == 1,
-                                         "External field reading is not implemented for more than one RZ mode (see #3829)");
-        ReadExternalFieldFromFile(external_fields_path, B_external_particle_field[lev][0].get(), "B", "r");
-        ReadExternalFieldFromFile(external_fields_path, B_external_particle_field[lev][1].get(), "B", "t");
-        ReadExternalFieldFromFile(external_fields_path, B_external_particle_field[lev][2].get(), "B", "z");
-#else
-        ReadExternalFieldFromFile(external_fields_path, B_external_particle_field[lev][0].get(), "B", "x");
-        ReadExternalFieldFromFile(external_fields_path, B_external_particle_field[lev][1].get(), "B", "y");
-        ReadExternalFieldFromFile(external_fields_path, B_external_particle_field[lev][2].get(), "B", "z");
-#endif
-    }
-    if (mypc->m_E_ext_particle_s == "read_from_file") {
+    if ( (mypc->m_B_ext_particle_s == "read_from_file") ||
+         (mypc->m_E_ext_particle_s == "read_from_file") ) {
         std::string external_fields_path;
+        bool time_dependent = false;
+        bool prefetch = false;
         const amrex::ParmParse pp_particles("particles");
         pp_particles.get("read_fields_from_path", external_fields_path );
+        pp_particles.query("read_fields_time_dependent", time_dependent);
+        pp_particles.query("read_fields_prefetch", prefetch);
 #if defined(WARPX_DIM_RZ)
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(n_rz_azimuthal_modes == 1,
                                          "External field reading is not implemented for more than one RZ mode (see #3829)");
-        ReadExternalFieldFromFile(external_fields_path, E_external_particle_field[lev][0].get(), "E", "r");
-        ReadExternalFieldFromFile(external_fields_path, E_external_particle_field[lev][1].get(), "E", "t");
-        ReadExternalFieldFromFile(external_fields_path, E_external_particle_field[lev][2].get(), "E", "z");
+        const std::array<std::string,3> components = {"r", "t", "z"};
 #else
-        ReadExternalFieldFromFile(external_fields_path, E_external_particle_field[lev][0].get(), "E", "x");
-        ReadExternalFieldFromFile(external_fields_path, E_external_particle_field[lev][1].get(), "E", "y");
-        ReadExternalFieldFromFile(external_fields_path, E_external_particle_field[lev][2].get(), "E", "z");
+        const std::array<std::string,3> components = {"x", "y", "z"};
 #endif
+
+        if (time_dependent) {
+            // The fields are updated at each time step in UpdateAuxilaryData
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(lev == 0 && maxLevel() == 0,
+                "particles.read_fields_time_dependent is not implemented with mesh refinement");
+            if (mypc->m_B_ext_particle_s == "read_from_file") {
+                m_B_external_particle_series = std::make_unique<ExternalFieldTimeSeries>(
+                    external_fields_path, "B", prefetch);
+                m_B_external_particle_series->Update(gett_new(lev),
+                    {B_external_particle_field[lev][0].get(),
+                     B_external_particle_field[lev][1].get(),
+                     B_external_particle_field[lev][2].get()});
+            }
+            if (mypc->m_E_ext_particle_s == "read_from_file") {
+                m_E_external_particle_series = std::make_unique<ExternalFieldTimeSeries>(
+                    external_fields_path, "E", prefetch);
+                m_E_external_particle_series->Update(gett_new(lev),
+                    {E_external_particle_field[lev][0].get(),
+                     E_external_particle_field[lev][1].get(),
+                     E_external_particle_field[lev][2].get()});
+            }
+        } else {
+            for (int idim = 0; idim < 3; ++idim) {
+                if (mypc->m_B_ext_particle_s == "read_from_file") {
+                    ReadExternalFieldFromFile(external_fields_path, B_external_particle_field[lev][idim].get(), "B", components[idim]);
+                }
+                if (mypc->m_E_ext_particle_s == "read_from_file") {
+                    ReadExternalFieldFromFile(external_fields_path, E_external_particle_field[lev][idim].get(), "E", components[idim]);
+                }
+            }
+        }
     }
 }
 
@@ -1452,177 +1457,16 @@ WarpX::ReadExternalFieldFromFile (
        const std::string& read_fields_from_path, amrex::MultiFab* mf,
        const std::string& F_name, const std::string& F_component)
 {
-    // Get WarpX domain info
-    auto& warpx = WarpX::GetInstance();
-    amrex::Geometry const& geom0 = warpx.Geom(0);
-    const amrex::RealBox& real_box = geom0.ProbDomain();
-    const auto dx = geom0.CellSizeArray();
-    const amrex::IntVect nodal_flag = mf->ixType().toIntVect();
-
-    // Read external field openPMD data
+    // Read external field openPMD data.
+    // Each rank only loads the part of the data that covers its boxes.
     auto series = openPMD::Series(read_fields_from_path, openPMD::Access::READ_ONLY);
-    auto iseries = series.iterations.begin()->second;
-    auto F = iseries.meshes[F_name];
-
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(F.getAttribute("dataOrder").get<std::string>() == "C",
-                                     "Reading from files with non-C dataOrder is not implemented");
-
-    auto axisLabels = F.getAttribute("axisLabels").get<std::vector<std::string>>();
-    auto fileGeom = F.getAttribute("geometry").get<std::string>();
-
-#if defined(WARPX_DIM_3D)
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fileGeom == "cartesian", "3D can only read from files with cartesian geometry");
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(axisLabels[0] == "x" && axisLabels[1] == "y" && axisLabels[2] == "z",
-                                     "3D expects axisLabels {x, y, z}");
-#elif defined(WARPX_DIM_XZ)
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fileGeom == "cartesian", "XZ can only read from files with cartesian geometry");
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(axisLabels[0] == "x" && axisLabels[1] == "z",
-                                     "XZ expects axisLabels {x, z}");
-#elif defined(WARPX_DIM_1D_Z)
-    WARPX_ABORT_WITH_MESSAGE(
-        "Reading from openPMD for external fields is not known to work with 1D3V (see #3830)");
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fileGeom == "cartesian", "1D3V can only read from files with cartesian geometry");
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(axisLabels[0] == "z");
-#elif defined(WARPX_DIM_RZ)
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fileGeom == "thetaMode", "RZ can only read from files with 'thetaMode'  geometry");
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(axisLabels[0] == "r" && axisLabels[1] == "z",
-                                     "RZ expects axisLabels {r, z}");
-#endif
-
-    const auto offset = F.gridGlobalOffset();
-    const auto offset0 = static_cast<amrex::Real>(offset[0]);
-    const auto offset1 = static_cast<amrex::Real>(offset[1]);
-#if defined(WARPX_DIM_3D)
-    const auto offset2 = static_cast<amrex::Real>(offset[2]);
-#endif
-    const auto d = F.gridSpacing<long double>();
-
-#if defined(WARPX_DIM_RZ)
-    const auto file_dr = static_cast<amrex::Real>(d[0]);
-    const auto file_dz = static_cast<amrex::Real>(d[1]);
-#elif defined(WARPX_DIM_3D)
-    const auto file_dx = static_cast<amrex::Real>(d[0]);
-    const auto file_dy = static_cast<amrex::Real>(d[1]);
-    const auto file_dz = static_cast<amrex::Real>(d[2]);
-#endif
-
-    auto FC = F[F_component];
-    const auto extent = FC.getExtent();
-    const auto extent0 = static_cast<int>(extent[0]);
-    const auto extent1 = static_cast<int>(extent[1]);
-    const auto extent2 = static_cast<int>(extent[2]);
-
-    // Determine the chunk data that will be loaded.
-    // Now, the full range of data is loaded.
-    // Loading chunk data can speed up the process.
-    // Thus, `chunk_offset` and `chunk_extent` should be modified accordingly in another PR.
-    const openPMD::Offset chunk_offset = {0,0,0};
-    const openPMD::Extent chunk_extent = {extent[0], extent[1], extent[2]};
-
-    auto FC_chunk_data = FC.loadChunk<double>(chunk_offset,chunk_extent);
-    series.flush();
-    auto *FC_data_host = FC_chunk_data.get();
-
-    // Load data to GPU
-    const size_t total_extent = size_t(extent[0]) * extent[1] * extent[2];
-    amrex::Gpu::DeviceVector<double> FC_data_gpu(total_extent);
-    auto *FC_data = FC_data_gpu.data();
-    amrex::Gpu::copy(amrex::Gpu::hostToDevice, FC_data_host, FC_data_host + total_extent, FC_data);
-
-    // Loop over boxes
-    for (MFIter mfi(*mf, TilingIfNotGPU()); mfi.isValid(); ++mfi)
-    {
-        const amrex::Box box = mfi.growntilebox();
-        const amrex::Box tb = mfi.tilebox(nodal_flag, mf->nGrowVect());
-        auto const& mffab = mf->array(mfi);
-
-        // Start ParallelFor
-        amrex::ParallelFor (tb,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) {
-                // i,j,k denote x,y,z indices in 3D xyz.
-                // i,j denote r,z indices in 2D rz; k is just 0
-
-                // ii is used for 2D RZ mode
-#if defined(WARPX_DIM_RZ)
-                // In 2D RZ, i denoting r can be < 0
-                // but mirrored values should be assigned.
-                // Namely, mffab(i) = FC_data[-i] when i<0.
-                const int ii = (i<0)?(-i):(i);
-#else
-                const int ii = i;
-#endif
-
-                // Physical coordinates of the grid point
-                // 0,1,2 denote x,y,z in 3D xyz.
-                // 0,1 denote r,z in 2D rz.
-                amrex::Real x0, x1;
-                if ( box.type(0)==amrex::IndexType::CellIndex::NODE )
-                     { x0 = static_cast<amrex::Real>(real_box.lo(0)) + ii*dx[0]; }
-                else { x0 = static_cast<amrex::Real>(real_box.lo(0)) + ii*dx[0] + 0.5_rt*dx[0]; }
-                if ( box.type(1)==amrex::IndexType::CellIndex::NODE )
-                     { x1 = real_box.lo(1) + j*dx[1]; }
-                else { x1 = real_box.lo(1) + j*dx[1] + 0.5_rt*dx[1]; }
-
-#if defined(WARPX_DIM_RZ)
-                // Get index of the external field array
-                int const ir = std::floor( (x0-offset0)/file_dr );
-                int const iz = std::floor( (x1-offset1)/file_dz );
-
-                // Get coordinates of external grid point
-                amrex::Real const xx0 = offset0 + ir * file_dr;
-                amrex::Real const xx1 = offset1 + iz * file_dz;
-
-#elif defined(WARPX_DIM_3D)
-                amrex::Real x2;
-                if ( box.type(2)==amrex::IndexType::CellIndex::NODE )
-                     { x2 = real_box.lo(2) + k*dx[2]; }
-                else { x2 = real_box.lo(2) + k*dx[2] + 0.5_rt*dx[2]; }
-
-                // Get index of the external field array
-                int const ix = std::floor( (x0-offset0)/file_dx );
-                int const iy = std::floor( (x1-offset1)/file_dy );
-                int const iz = std::floor( (x2-offset2)/file_dz );
-
-                // Get coordinates of external grid point
-                amrex::Real const xx0 = offset0 + ix * file_dx;
-                amrex::Real const xx1 = offset1 + iy * file_dy;
-                amrex::Real const xx2 = offset2 + iz * file_dz;
-#endif
-
-#if defined(WARPX_DIM_RZ)
-                const amrex::Array4<double> fc_array(FC_data, {0,0,0}, {extent0, extent2, extent1}, 1);
-                const double
-                    f00 = fc_array(0, iz  , ir  ),
-                    f01 = fc_array(0, iz  , ir+1),
-                    f10 = fc_array(0, iz+1, ir  ),
-                    f11 = fc_array(0, iz+1, ir+1);
-                mffab(i,j,k) = static_cast<amrex::Real>(utils::algorithms::bilinear_interp<double>
-                    (xx0, xx0+file_dr, xx1, xx1+file_dz,
-                     f00, f01, f10, f11,
-                     x0, x1));
-#elif defined(WARPX_DIM_3D)
-                const amrex::Array4<double> fc_array(FC_data, {0,0,0}, {extent2, extent1, extent0}, 1);
-                const double
-                    f000 = fc_array(iz  , iy  , ix  ),
-                    f001 = fc_array(iz+1, iy  , ix  ),
-                    f010 = fc_array(iz  , iy+1, ix  ),
-                    f011 = fc_array(iz+1, iy+1, ix  ),
-                    f100 = fc_array(iz  , iy  , ix+1),
-                    f101 = fc_array(iz+1, iy  , ix+1),
-                    f110 = fc_array(iz  , iy+1, ix+1),
-                    f111 = fc_array(iz+1, iy+1, ix+1);
-                mffab(i,j,k) = static_cast<amrex::Real>(utils::algorithms::trilinear_interp<double>
-                    (xx0, xx0+file_dx, xx1, xx1+file_dy, xx2, xx2+file_dz,
-                     f000, f001, f010, f011, f100, f101, f110, f111,
-                     x0, x1, x2));
-#endif
-
-            }
-
-        ); // End ParallelFor
+    const auto iteration = series.iterations.begin()->first;
 
-    } // End loop over boxes.
+    const auto chunk = external_field_reader::ReadFieldChunk(
+        series, iteration, F_name, F_component,
+        external_field_reader::LocalPhysicalBounds(*mf));
 
+    external_field_reader::InterpolateFieldChunk(chunk, *mf);
 } // End function WarpX::ReadExternalFieldFromFile
 #else // WARPX_USE_OPENPMD && !WARPX_DIM_1D_Z && !defined(WARPX_DIM_XZ)
 void
@@ -30,9 +30,11 @@
 #include <AMReX_Vector.H>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdint>
 #include <fstream>
+#include <future>
 #include <iterator>
 #include <limits>
 #include <string>
@@ -42,6 +44,10 @@
 #include <iostream>
 #include <memory>
 
+#ifdef AMREX_USE_MPI
+#   include <mpi.h>
+#endif
+
 #ifdef WARPX_USE_OPENPMD
 #   include <openPMD/openPMD.hpp>
     namespace io = openPMD;
@@ -99,13 +105,26 @@ WarpXLaserProfiles::FromFileLaserProfile::init (
     }
     //Reads the (optional) delay
     utils::parser::queryWithParser(ppl, "delay", m_params.t_delay);
+    //Reads whether the next time chunk is read in a background thread
+    ppl.query("prefetch_time_chunks", m_params.prefetch_time_chunks);
 
-    //Read first time chunk
-    if (m_params.file_in_lasy_format){
-        read_data_t_chunk(0, m_params.time_chunk_size);
-    } else{
-        read_binary_data_t_chunk(0, m_params.time_chunk_size);
+    //Read first time chunk on the I/O rank and broadcast it
+    TimeChunk chunk = allocate_t_chunk(0, m_params.time_chunk_size);
+    if(ParallelDescriptor::IOProcessor()){
+        amrex::Print() << Utils::TextMsg::Info(
+            "Reading [" + std::to_string(chunk.first_time_index) + ", " +
+            std::to_string(chunk.last_time_index) + "] data chunk from " +
+            (m_params.file_in_lasy_format ? m_params.lasy_file_name : m_params.binary_file_name));
+        if (m_params.file_in_lasy_format){
+            read_data_t_chunk(chunk);
+        } else{
+            read_binary_data_t_chunk(chunk);
+        }
     }
+    broadcast_t_chunk(chunk, ParallelDescriptor::IOProcessorNumber(), ParallelDescriptor::Communicator());
+    install_t_chunk(chunk);
+    m_reads_chunks = ParallelDescriptor::IOProcessor();
+
     //Copy common params
     m_common_params = params;
 }
@@ -120,16 +139,91 @@ WarpXLaserProfiles::FromFileLaserProfile::update (amrex::Real t)
     const auto idx_times = find_left_right_time_indices(t);
     const auto idx_t_left = idx_times.first;
     const auto idx_t_right = idx_times.second;
-    //Load data chunk if needed
-    if(idx_t_right >  m_params.last_time_index){
-        if (m_params.file_in_lasy_format){
-            read_data_t_chunk(idx_t_left, idx_t_left+m_params.time_chunk_size);
-        } else{
-            read_binary_data_t_chunk(idx_t_left, idx_t_left+m_params.time_chunk_size);
+    //Only the ranks that own particles of the antenna need the field data
+    const bool needs_chunk = m_owns_antenna &&
+        (idx_t_left < m_params.first_time_index || idx_t_right > m_params.last_time_index);
+    bool any_needs_chunk = needs_chunk;
+    ParallelDescriptor::ReduceBoolOr(any_needs_chunk);
+    if(any_needs_chunk){
+        //The new chunk is read by one of the ranks that need it and broadcast to the others.
+        //These ranks are gathered in a sub-communicator, in which a rank that already
+        //prefetched a chunk comes first.
+        int sub_rank = 0;
+#ifdef AMREX_USE_MPI
+        MPI_Comm sub_comm = MPI_COMM_NULL;
+        BL_MPI_REQUIRE( MPI_Comm_split(ParallelDescriptor::Communicator(),
+                                       needs_chunk ? 0 : MPI_UNDEFINED,
+                                       m_prefetch.valid() ? 0 : 1, &sub_comm) );
+        if (needs_chunk){
+            BL_MPI_REQUIRE( MPI_Comm_rank(sub_comm, &sub_rank) );
         }
+#endif
+        if (needs_chunk){
+            TimeChunk chunk;
+            //Whether the chunk was prefetched, and index of its first timestep
+            std::array<int,2> chunk_info = {0, idx_t_left};
+            if (sub_rank == 0){
+                if (m_prefetch.valid()){
+                    // Wait for the chunk being read in the background, and use it if it contains the current time
+                    chunk = m_prefetch.get();
+                    chunk_info[0] = (idx_t_left >= chunk.first_time_index && idx_t_right <= chunk.last_time_index);
+                }
+                if (!chunk_info[0]){
+                    chunk = read_t_chunk(idx_t_left, idx_t_left+m_params.time_chunk_size);
+                }
+                chunk_info[1] = chunk.first_time_index;
+            } else{
+                // Only the rank that reads the chunks prefetches them
+                cancel_t_chunk_prefetch();
+            }
+#ifdef AMREX_USE_MPI
+            ParallelDescriptor::Bcast(chunk_info.data(), chunk_info.size(), 0, sub_comm);
+            if (sub_rank != 0){
+                chunk = allocate_t_chunk(chunk_info[1], chunk_info[1]+m_params.time_chunk_size);
+            }
+            broadcast_t_chunk(chunk, 0, sub_comm);
+            BL_MPI_REQUIRE( MPI_Comm_free(&sub_comm) );
+#endif
+            install_t_chunk(chunk);
+            m_reads_chunks = (sub_rank == 0);
+            if (chunk_info[0]){
+                ++m_prefetch_hits;
+            } else{
+                ++m_prefetch_misses;
+            }
+            if (m_reads_chunks){
+                amrex::AllPrint() << Utils::TextMsg::Info(
+                    "Using [" + std::to_string(chunk.first_time_index) + ", " +
+                    std::to_string(chunk.last_time_index) + "] data chunk from " +
+                    (m_params.file_in_lasy_format ? m_params.lasy_file_name : m_params.binary_file_name) +
+                    " (prefetch hits: " + std::to_string(m_prefetch_hits) +
+                    ", misses: " + std::to_string(m_prefetch_misses) + ")");
+            }
+        }
+    }
+    //Read the next chunk in the background while the current one is in use
+    if (m_reads_chunks && !m_prefetch.valid()){
+        start_t_chunk_prefetch();
     }
 }
 
+void
+WarpXLaserProfiles::FromFileLaserProfile::set_antenna_ownership (bool owns_antenna)
+{
+    m_owns_antenna = owns_antenna;
+    // A rank that does not need the field data anymore does not read the next chunks
+    if (!m_owns_antenna){
+        m_reads_chunks = false;
+        cancel_t_chunk_prefetch();
+    }
+}
+
+std::pair<int,int>
+WarpXLaserProfiles::FromFileLaserProfile::chunk_prefetch_statistics () const
+{
+    return std::make_pair(m_prefetch_hits, m_prefetch_misses);
+}
+
 void
 WarpXLaserProfiles::FromFileLaserProfile::fill_amplitude (
     const int np,
@@ -309,119 +403,165 @@ WarpXLaserProfiles::FromFileLaserProfile::find_left_right_time_indices(amrex::Re
     return std::make_pair(idx_t_right-1, idx_t_right);
 }
 
+WarpXLaserProfiles::FromFileLaserProfile::TimeChunk
+WarpXLaserProfiles::FromFileLaserProfile::allocate_t_chunk (int t_begin, int t_end) const
+{
+    TimeChunk chunk;
+    //Indices of the first and last timestep to read
+    chunk.first_time_index = max(0, t_begin);
+    chunk.last_time_index = min(t_end-1, m_params.nt-1);
+    const int nt_chunk = chunk.last_time_index - chunk.first_time_index + 1;
+    if (m_params.file_in_lasy_format){
+        const auto data_size =
+            (m_params.file_in_cartesian_geom==0)?
+            (m_params.n_rz_azimuthal_components*nt_chunk*m_params.nr) :
+            nt_chunk*m_params.nx*m_params.ny;
+        chunk.E_lasy_data.resize(data_size);
+    } else{
+        chunk.E_binary_data.resize(nt_chunk*m_params.nx*m_params.ny);
+    }
+    return chunk;
+}
+
 void
-WarpXLaserProfiles::FromFileLaserProfile::read_data_t_chunk (int t_begin, int t_end)
+WarpXLaserProfiles::FromFileLaserProfile::read_data_t_chunk (TimeChunk& chunk) const
 {
 #ifdef WARPX_USE_OPENPMD
     //Indices of the first and last timestep to read
-    auto const i_first = static_cast<long unsigned int>(max(0, t_begin));
-    auto const i_last = static_cast<long unsigned int>(min(t_end-1, m_params.nt-1));
-    amrex::Print() << Utils::TextMsg::Info(
-        "Reading [" + std::to_string(i_first) + ", " + std::to_string(i_last) +
-            "] data chunk from " + m_params.lasy_file_name);
-    const auto data_size =
-        (m_params.file_in_cartesian_geom==0)?
-        (m_params.n_rz_azimuthal_components*(i_last-i_first+1)*m_params.nr) :
-        (i_last-i_first+1)*m_params.nx*m_params.ny;
-    m_params.E_lasy_data.resize(data_size);
-    Vector<Complex> h_E_lasy_data(m_params.E_lasy_data.size());
-    if(ParallelDescriptor::IOProcessor()){
-        auto series = io::Series(m_params.lasy_file_name, io::Access::READ_ONLY);
-        auto i = series.iterations[0];
-        auto E = i.meshes["laserEnvelope"];
-        auto E_laser = E[io::RecordComponent::SCALAR];
-        openPMD:: Extent full_extent = E_laser.getExtent();
-        if (m_params.file_in_cartesian_geom==0) {
-            const openPMD::Extent read_extent = { full_extent[0], (i_last - i_first + 1), full_extent[2]};
-            auto r_data = E_laser.loadChunk< std::complex<double> >(io::Offset{ 0, i_first,  0}, read_extent);
-            const auto read_size = (i_last - i_first + 1)*m_params.nr;
-            series.flush();
-            for (int m=0; m<m_params.n_rz_azimuthal_components; m++){
-                for (auto j=0u; j<read_size; j++) {
-                    h_E_lasy_data[j+m*read_size] = Complex{
-                        static_cast<amrex::Real>(r_data.get()[j+m*read_size].real()),
-                        static_cast<amrex::Real>(r_data.get()[j+m*read_size].imag())};
-                }
-            }
-        } else{
-            const openPMD::Extent read_extent = {(i_last - i_first + 1), full_extent[1], full_extent[2]};
-            auto x_data = E_laser.loadChunk< std::complex<double> >(io::Offset{i_first, 0, 0}, read_extent);
-            const auto read_size = (i_last - i_first + 1)*m_params.nx*m_params.ny;
-            series.flush();
+    auto const i_first = static_cast<long unsigned int>(chunk.first_time_index);
+    auto const i_last = static_cast<long unsigned int>(chunk.last_time_index);
+    auto& h_E_lasy_data = chunk.E_lasy_data;
+    auto series = io::Series(m_params.lasy_file_name, io::Access::READ_ONLY);
+    auto i = series.iterations[0];
+    auto E = i.meshes["laserEnvelope"];
+    auto E_laser = E[io::RecordComponent::SCALAR];
+    openPMD:: Extent full_extent = E_laser.getExtent();
+    if (m_params.file_in_cartesian_geom==0) {
+        const openPMD::Extent read_extent = { full_extent[0], (i_last - i_first + 1), full_extent[2]};
+        auto r_data = E_laser.loadChunk< std::complex<double> >(io::Offset{ 0, i_first,  0}, read_extent);
+        const auto read_size = (i_last - i_first + 1)*m_params.nr;
+        series.flush();
+        for (int m=0; m<m_params.n_rz_azimuthal_components; m++){
             for (auto j=0u; j<read_size; j++) {
-                h_E_lasy_data[j] = Complex{
-                    static_cast<amrex::Real>(x_data.get()[j].real()),
-                    static_cast<amrex::Real>(x_data.get()[j].imag())};
+                h_E_lasy_data[j+m*read_size] = Complex{
+                    static_cast<amrex::Real>(r_data.get()[j+m*read_size].real()),
+                    static_cast<amrex::Real>(r_data.get()[j+m*read_size].imag())};
             }
         }
+    } else{
+        const openPMD::Extent read_extent = {(i_last - i_first + 1), full_extent[1], full_extent[2]};
+        auto x_data = E_laser.loadChunk< std::complex<double> >(io::Offset{i_first, 0, 0}, read_extent);
+        const auto read_size = (i_last - i_first + 1)*m_params.nx*m_params.ny;
+        series.flush();
+        for (auto j=0u; j<read_size; j++) {
+            h_E_lasy_data[j] = Complex{
+                static_cast<amrex::Real>(x_data.get()[j].real()),
+                static_cast<amrex::Real>(x_data.get()[j].imag())};
+        }
     }
-    //Broadcast E_lasy_data
-    ParallelDescriptor::Bcast(h_E_lasy_data.dataPtr(),
-        h_E_lasy_data.size(), ParallelDescriptor::IOProcessorNumber());
-    Gpu::copyAsync(Gpu::hostToDevice,h_E_lasy_data.begin(),h_E_lasy_data.end(),m_params.E_lasy_data.begin());
-    Gpu::synchronize();
-    //Update first and last indices
-    m_params.first_time_index = static_cast<int>(i_first);
-    m_params.last_time_index = static_cast<int>(i_last);
 #else
-    amrex::ignore_unused(t_begin, t_end);
+    amrex::ignore_unused(chunk);
 #endif
 }
 
 void
-WarpXLaserProfiles::FromFileLaserProfile::read_binary_data_t_chunk (int t_begin, int t_end)
+WarpXLaserProfiles::FromFileLaserProfile::read_binary_data_t_chunk (TimeChunk& chunk) const
 {
-    amrex::Print() << Utils::TextMsg::Info(
-        "Reading [" + std::to_string(t_begin) + ", " + std::to_string(t_end) +
-            "] data chunk from " + m_params.binary_file_name);
-
     //Indices of the first and last timestep to read
-    auto i_first = max(0, t_begin);
-    auto i_last = min(t_end-1, m_params.nt-1);
-    const int data_size = (i_last-i_first+1)*m_params.nx*m_params.ny;
-    m_params.E_binary_data.resize(data_size);
-    Vector<Real> h_E_binary_data(m_params.E_binary_data.size());
-    if(ParallelDescriptor::IOProcessor()){
-        //Read data chunk
-        std::ifstream inp(m_params.binary_file_name, std::ios::binary);
-        if(!inp) { WARPX_ABORT_WITH_MESSAGE("Failed to open binary file"); }
-        inp.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    const auto i_first = chunk.first_time_index;
+    const auto i_last = chunk.last_time_index;
+    auto& h_E_binary_data = chunk.E_binary_data;
+    //Read data chunk
+    std::ifstream inp(m_params.binary_file_name, std::ios::binary);
+    if(!inp) { WARPX_ABORT_WITH_MESSAGE("Failed to open binary file"); }
+    inp.exceptions(std::ios_base::failbit | std::ios_base::badbit);
 #if (defined(WARPX_DIM_3D))
-        auto skip_amount = 1 +
-        3*sizeof(uint32_t) +
-        2*sizeof(double) +
-        2*sizeof(double) +
-        2*sizeof(double) +
-        sizeof(double)*t_begin*m_params.nx*m_params.ny;
+    auto skip_amount = 1 +
+    3*sizeof(uint32_t) +
+    2*sizeof(double) +
+    2*sizeof(double) +
+    2*sizeof(double) +
+    sizeof(double)*i_first*m_params.nx*m_params.ny;
 #else
-        auto skip_amount = 1 +
-        3*sizeof(uint32_t) +
-        2*sizeof(double) +
-        2*sizeof(double) +
-        1*sizeof(double) +
-        sizeof(double)*t_begin*m_params.nx*m_params.ny;
+    auto skip_amount = 1 +
+    3*sizeof(uint32_t) +
+    2*sizeof(double) +
+    2*sizeof(double) +
+    1*sizeof(double) +
+    sizeof(double)*i_first*m_params.nx*m_params.ny;
 #endif
-        inp.seekg(static_cast<std::streamoff>(skip_amount));
-        if(!inp) { WARPX_ABORT_WITH_MESSAGE("Failed to read field data from binary file"); }
-        const int read_size = (i_last - i_first + 1)*
-            m_params.nx*m_params.ny;
-        Vector<double> buf_e(read_size);
-        inp.read(reinterpret_cast<char*>(buf_e.dataPtr()), static_cast<std::streamsize>(read_size*sizeof(double)));
-        if(!inp) { WARPX_ABORT_WITH_MESSAGE("Failed to read field data from binary file"); }
-        std::transform(buf_e.begin(), buf_e.end(), h_E_binary_data.begin(),
-            [](auto x) {return static_cast<amrex::Real>(x);} );
+    inp.seekg(static_cast<std::streamoff>(skip_amount));
+    if(!inp) { WARPX_ABORT_WITH_MESSAGE("Failed to read field data from binary file"); }
+    const int read_size = (i_last - i_first + 1)*
+        m_params.nx*m_params.ny;
+    Vector<double> buf_e(read_size);
+    inp.read(reinterpret_cast<char*>(buf_e.dataPtr()), static_cast<std::streamsize>(read_size*sizeof(double)));
+    if(!inp) { WARPX_ABORT_WITH_MESSAGE("Failed to read field data from binary file"); }
+    std::transform(buf_e.begin(), buf_e.end(), h_E_binary_data.begin(),
+        [](auto x) {return static_cast<amrex::Real>(x);} );
+}
+
+WarpXLaserProfiles::FromFileLaserProfile::TimeChunk
+WarpXLaserProfiles::FromFileLaserProfile::read_t_chunk (int t_begin, int t_end) const
+{
+    TimeChunk chunk = allocate_t_chunk(t_begin, t_end);
+    if (m_params.file_in_lasy_format){
+        read_data_t_chunk(chunk);
+    } else{
+        read_binary_data_t_chunk(chunk);
     }
+    return chunk;
+}
 
-    //Broadcast E_binary_data
-    ParallelDescriptor::Bcast(h_E_binary_data.dataPtr(),
-        h_E_binary_data.size(), ParallelDescriptor::IOProcessorNumber());
+void
+WarpXLaserProfiles::FromFileLaserProfile::broadcast_t_chunk (TimeChunk& chunk, int root, MPI_Comm comm) const
+{
+    if (m_params.file_in_lasy_format){
+        ParallelDescriptor::Bcast(chunk.E_lasy_data.dataPtr(),
+            chunk.E_lasy_data.size(), root, comm);
+    } else{
+        ParallelDescriptor::Bcast(chunk.E_binary_data.dataPtr(),
+            chunk.E_binary_data.size(), root, comm);
+    }
+}
 
-    Gpu::copyAsync(Gpu::hostToDevice,h_E_binary_data.begin(),h_E_binary_data.end(),m_params.E_binary_data.begin());
+void
+WarpXLaserProfiles::FromFileLaserProfile::install_t_chunk (const TimeChunk& chunk)
+{
+    if (m_params.file_in_lasy_format){
+        m_params.E_lasy_data.resize(chunk.E_lasy_data.size());
+        Gpu::copyAsync(Gpu::hostToDevice,chunk.E_lasy_data.begin(),chunk.E_lasy_data.end(),m_params.E_lasy_data.begin());
+    } else{
+        m_params.E_binary_data.resize(chunk.E_binary_data.size());
+        Gpu::copyAsync(Gpu::hostToDevice,chunk.E_binary_data.begin(),chunk.E_binary_data.end(),m_params.E_binary_data.begin());
+    }
     Gpu::synchronize();
-
     //Update first and last indices
-    m_params.first_time_index = static_cast<int>(i_first);
-    m_params.last_time_index = static_cast<int>(i_last);
+    m_params.first_time_index = chunk.first_time_index;
+    m_params.last_time_index = chunk.last_time_index;
+}
+
+void
+WarpXLaserProfiles::FromFileLaserProfile::start_t_chunk_prefetch ()
+{
+    // The next chunk starts at the last timestep of the current one,
+    // which is the left time index as soon as the current chunk is exhausted
+    const int t_begin = m_params.last_time_index;
+    if (!m_params.prefetch_time_chunks || t_begin >= m_params.nt-1) {
+        return;
+    }
+    const int t_end = t_begin + m_params.time_chunk_size;
+    m_prefetch = std::async(std::launch::async,
+        [this, t_begin, t_end] () { return read_t_chunk(t_begin, t_end); });
+}
+
+void
+WarpXLaserProfiles::FromFileLaserProfile::cancel_t_chunk_prefetch ()
+{
+    if (m_prefetch.valid()){
+        m_prefetch.wait();
+    }
+    m_prefetch = {};
 }
 
 void
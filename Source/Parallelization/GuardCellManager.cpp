@@ -43,6 +43,7 @@ guardCellManager::Init (
     const int nox_fft, const int noy_fft, const int noz_fft,
     const int nci_corr_stencil,
     const int electromagnetic_solver_id,
+    const bool do_fdtd_temporal_blocking,
     const int max_level,
     const amrex::Vector<amrex::Real>& v_galilean,
     const amrex::Vector<amrex::Real>& v_comoving,
@@ -290,6 +291,14 @@ guardCellManager::Init (
     ng_alloc_F.max( ng_FieldSolverF );
     ng_alloc_G.max( ng_FieldSolverG );
 
+    // The temporally-blocked FDTD push recomputes E and B in three layers of guard
+    // cells (of the width of the stencil), and uses J in the first layer
+    if (do_fdtd_temporal_blocking) {
+        ng_FieldSolverBlocked = 3*ng_FieldSolver;
+        ng_alloc_EB.max( ng_FieldSolverBlocked );
+        ng_alloc_J.max( ng_FieldSolver );
+    }
+
     if (do_moving_window && electromagnetic_solver_id == ElectromagneticSolverAlgo::PSATD) {
         ng_afterPushPSATD = ng_alloc_EB;
     }
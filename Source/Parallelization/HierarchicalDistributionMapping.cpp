@@ -0,0 +1,189 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "HierarchicalDistributionMapping.H"
+
+#include <AMReX_Box.H>
+#include <AMReX_Config.H>
+#include <AMReX_ParallelDescriptor.H>
+
+#ifdef AMREX_USE_MPI
+#   include <mpi.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+using namespace amrex;
+
+namespace
+{
+    /** Position of a cell along the Morton (Z-order) curve */
+    std::uint64_t MortonKey (const IntVect& iv)
+    {
+        constexpr int nbits = 64 / AMREX_SPACEDIM;
+        std::uint64_t key = 0;
+        for (int b = nbits-1; b >= 0; --b) {
+            for (int idim = AMREX_SPACEDIM-1; idim >= 0; --idim) {
+                key = (key << 1) | ((static_cast<std::uint64_t>(iv[idim]) >> b) & 1U);
+            }
+        }
+        return key;
+    }
+
+    /** Cut a sequence of items into contiguous parts, whose costs are
+     *  proportional to the weights of the parts; returns the part of each item */
+    std::vector<int> PartitionCurve (const std::vector<Real>& cost, const std::vector<Real>& weight)
+    {
+        const auto nitems = static_cast<int>(cost.size());
+        const auto nparts = static_cast<int>(weight.size());
+
+        Real total_cost = std::accumulate(cost.begin(), cost.end(), Real(0.));
+        // Without costs (e.g. before they are measured), balance the number of items
+        const bool use_count = (total_cost <= Real(0.));
+        if (use_count) { total_cost = static_cast<Real>(nitems); }
+        const Real total_weight = std::accumulate(weight.begin(), weight.end(), Real(0.));
+
+        std::vector<int> part_of_item(nitems);
+        int part = 0;
+        Real cost_before = 0.;
+        Real part_end = total_cost*weight[0]/total_weight;
+        for (int i = 0; i < nitems; ++i) {
+            const Real item_cost = use_count ? Real(1.) : cost[i];
+            // An item belongs to the part that contains its middle
+            const Real middle = cost_before + Real(0.5)*item_cost;
+            while (part < nparts-1 && middle > part_end) {
+                ++part;
+                part_end += total_cost*weight[part]/total_weight;
+            }
+            part_of_item[i] = part;
+            cost_before += item_cost;
+        }
+        return part_of_item;
+    }
+}
+
+amrex::Vector<int>
+HierarchicalDistributionMapping::GetNodeOfRanks (int ranks_per_node)
+{
+    const int nprocs = ParallelDescriptor::NProcs();
+    Vector<int> node_of_rank(nprocs, 0);
+
+    if (ranks_per_node > 0) {
+        for (int rank = 0; rank < nprocs; ++rank) { node_of_rank[rank] = rank / ranks_per_node; }
+        return node_of_rank;
+    }
+
+#ifdef AMREX_USE_MPI
+    // The lowest rank of each node identifies the node
+    MPI_Comm node_comm;
+    BL_MPI_REQUIRE( MPI_Comm_split_type(ParallelDescriptor::Communicator(), MPI_COMM_TYPE_SHARED,
+                                        ParallelDescriptor::MyProc(), MPI_INFO_NULL, &node_comm) );
+    int node_leader = ParallelDescriptor::MyProc();
+    BL_MPI_REQUIRE( MPI_Bcast(&node_leader, 1, MPI_INT, 0, node_comm) );
+    BL_MPI_REQUIRE( MPI_Comm_free(&node_comm) );
+
+    Vector<int> leaders(nprocs);
+    BL_MPI_REQUIRE( MPI_Allgather(&node_leader, 1, MPI_INT, leaders.data(), 1, MPI_INT,
+                                  ParallelDescriptor::Communicator()) );
+
+    // Number the nodes in the order of their lowest rank
+    std::map<int, int> node_of_leader;
+    for (const int leader : leaders) {
+        node_of_leader.emplace(leader, static_cast<int>(node_of_leader.size()));
+    }
+    for (int rank = 0; rank < nprocs; ++rank) { node_of_rank[rank] = node_of_leader[leaders[rank]]; }
+#endif
+
+    return node_of_rank;
+}
+
+amrex::DistributionMapping
+HierarchicalDistributionMapping::MakeHierarchicalSFC (const amrex::Vector<amrex::Real>& rcost,
+                                                      const amrex::BoxArray& ba,
+                                                      const amrex::Vector<int>& node_of_rank)
+{
+    const auto nboxes = static_cast<int>(ba.size());
+    const int nnodes = *std::max_element(node_of_rank.begin(), node_of_rank.end()) + 1;
+
+    std::vector<std::vector<int>> ranks_of_node(nnodes);
+    for (int rank = 0; rank < static_cast<int>(node_of_rank.size()); ++rank) {
+        ranks_of_node[node_of_rank[rank]].push_back(rank);
+    }
+
+    // Order the boxes along the space-filling curve
+    const IntVect lo = ba.minimalBox().smallEnd();
+    std::vector<std::pair<std::uint64_t, int>> keys(nboxes);
+    for (int i = 0; i < nboxes; ++i) { keys[i] = {MortonKey(ba[i].smallEnd() - lo), i}; }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<Real> cost_along_curve(nboxes);
+    for (int i = 0; i < nboxes; ++i) { cost_along_curve[i] = rcost[keys[i].second]; }
+
+    // First level: nodes, weighted by their number of ranks
+    std::vector<Real> node_weight(nnodes);
+    for (int node = 0; node < nnodes; ++node) {
+        node_weight[node] = static_cast<Real>(ranks_of_node[node].size());
+    }
+    const std::vector<int> node_of_item = PartitionCurve(cost_along_curve, node_weight);
+
+    // Second level: ranks of each node
+    Vector<int> pmap(nboxes);
+    int begin = 0;
+    while (begin < nboxes) {
+        const int node = node_of_item[begin];
+        int end = begin;
+        while (end < nboxes && node_of_item[end] == node) { ++end; }
+
+        const std::vector<Real> node_cost(cost_along_curve.begin() + begin,
+                                          cost_along_curve.begin() + end);
+        const std::vector<Real> rank_weight(ranks_of_node[node].size(), Real(1.));
+        const std::vector<int> rank_of_item = PartitionCurve(node_cost, rank_weight);
+        for (int i = begin; i < end; ++i) {
+            pmap[keys[i].second] = ranks_of_node[node][rank_of_item[i-begin]];
+        }
+        begin = end;
+    }
+
+    return DistributionMapping(std::move(pmap));
+}
+
+amrex::Real
+HierarchicalDistributionMapping::Efficiency (const amrex::Vector<amrex::Real>& rcost,
+                                             const amrex::Vector<int>& pmap, int nprocs)
+{
+    std::vector<Real> rank_cost(nprocs, 0.);
+    for (int i = 0; i < static_cast<int>(pmap.size()); ++i) { rank_cost[pmap[i]] += rcost[i]; }
+    const Real max_cost = *std::max_element(rank_cost.begin(), rank_cost.end());
+    if (max_cost <= Real(0.)) { return Real(1.); }
+    const Real mean_cost = std::accumulate(rank_cost.begin(), rank_cost.end(), Real(0.))/nprocs;
+    return mean_cost/max_cost;
+}
+
+HierarchicalDistributionMapping::ExchangeVolume
+HierarchicalDistributionMapping::EstimateExchangeVolume (const amrex::BoxArray& ba,
+                                                         const amrex::Vector<int>& pmap,
+                                                         const amrex::Vector<int>& node_of_rank,
+                                                         const amrex::IntVect& ng)
+{
+    // Guard cells of box i that are filled by another box j (periodic images are not included)
+    ExchangeVolume volume;
+    const BoxArray ba_cc = amrex::convert(ba, IndexType::TheCellType());
+    for (int i = 0; i < static_cast<int>(ba_cc.size()); ++i) {
+        for (auto const& [j, bx] : ba_cc.intersections(amrex::grow(ba_cc[i], ng))) {
+            if (j == i || pmap[i] == pmap[j]) { continue; }
+            volume.inter_rank_cells += bx.numPts();
+            if (node_of_rank[pmap[i]] != node_of_rank[pmap[j]]) {
+                volume.inter_node_cells += bx.numPts();
+            }
+        }
+    }
+    return volume;
+}
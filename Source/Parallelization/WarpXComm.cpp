@@ -13,6 +13,8 @@
 #   include "BoundaryConditions/PML_RZ.H"
 #endif
 #include "Filter/BilinearFilter.H"
+#include "Initialization/ExternalFieldReader.H"
+#include "Utils/TelemetryTimers.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
@@ -61,6 +63,20 @@ WarpX::UpdateAuxilaryData ()
         UpdateAuxilaryDataStagToNodal();
     }
 
+    // Time-dependent particle fields from file: interpolate to the current time
+    if (m_E_external_particle_series) {
+        m_E_external_particle_series->Update(gett_new(0),
+            {E_external_particle_field[0][0].get(),
+             E_external_particle_field[0][1].get(),
+             E_external_particle_field[0][2].get()});
+    }
+    if (m_B_external_particle_series) {
+        m_B_external_particle_series->Update(gett_new(0),
+            {B_external_particle_field[0][0].get(),
+             B_external_particle_field[0][1].get(),
+             B_external_particle_field[0][2].get()});
+    }
+
     // When loading particle fields from file: add the external fields:
     for (int lev = 0; lev <= finest_level; ++lev) {
         if (mypc->m_E_ext_particle_s == "read_from_file") {
@@ -665,6 +681,7 @@ WarpX::FillBoundaryE (int lev, IntVect ng, std::optional<bool> nodal_sync)
 void
 WarpX::FillBoundaryE (const int lev, const PatchType patch_type, const amrex::IntVect ng, std::optional<bool> nodal_sync)
 {
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::Communication);
     std::array<amrex::MultiFab*,3> mf;
     amrex::Periodicity period;
 
@@ -722,6 +739,7 @@ WarpX::FillBoundaryB (int lev, IntVect ng, std::optional<bool> nodal_sync)
 void
 WarpX::FillBoundaryB (const int lev, const PatchType patch_type, const amrex::IntVect ng, std::optional<bool> nodal_sync)
 {
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::Communication);
     std::array<amrex::MultiFab*,3> mf;
     amrex::Periodicity period;
 
@@ -884,6 +902,7 @@ WarpX::FillBoundaryF (int lev, IntVect ng, std::optional<bool> nodal_sync)
 void
 WarpX::FillBoundaryF (int lev, PatchType patch_type, IntVect ng, std::optional<bool> nodal_sync)
 {
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::Communication);
     if (patch_type == PatchType::fine)
     {
         if (do_pml && pml[lev] && pml[lev]->ok())
@@ -972,6 +991,7 @@ WarpX::FillBoundaryAux (IntVect ng)
 void
 WarpX::FillBoundaryAux (int lev, IntVect ng)
 {
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::Communication);
     const amrex::Periodicity& period = Geom(lev).periodicity();
     ablastr::utils::communication::FillBoundary(*Efield_aux[lev][0], ng, WarpX::do_single_precision_comms, period);
     ablastr::utils::communication::FillBoundary(*Efield_aux[lev][1], ng, WarpX::do_single_precision_comms, period);
@@ -988,6 +1008,7 @@ WarpX::SyncCurrent (
     const amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,3>>& J_buffer)
 {
     WARPX_PROFILE("WarpX::SyncCurrent()");
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::Communication);
 
     // If warpx.do_current_centering = 1, center currents from nodal grid to staggered grid
     if (do_current_centering)
@@ -1155,6 +1176,7 @@ WarpX::SyncRho (
     const amrex::Vector<std::unique_ptr<amrex::MultiFab>>& charge_buffer)
 {
     WARPX_PROFILE("WarpX::SyncRho()");
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::Communication);
 
     if (!charge_fp[0]) { return; }
     const int ncomp = charge_fp[0]->nComp();
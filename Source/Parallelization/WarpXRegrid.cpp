@@ -13,6 +13,7 @@
 #include "EmbeddedBoundary/WarpXFaceInfoBox.H"
 #include "FieldSolver/FiniteDifferenceSolver/HybridPICModel/HybridPICModel.H"
 #include "Initialization/ExternalField.H"
+#include "Parallelization/HierarchicalDistributionMapping.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/ParticleBoundaryBuffer.H"
 #include "Particles/WarpXParticleContainer.H"
@@ -45,6 +46,7 @@
 #include <cmath>
 #include <cstddef>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -101,17 +103,62 @@ WarpX::LoadBalance ()
         amrex::Real currentEfficiency = 0.0;
         amrex::Real proposedEfficiency = 0.0;
 
-        newdm = (load_balance_with_sfc)
-            ? DistributionMapping::makeSFC(*costs[lev],
-                                           currentEfficiency, proposedEfficiency,
-                                           false,
-                                           ParallelDescriptor::IOProcessorNumber())
-            : DistributionMapping::makeKnapSack(*costs[lev],
-                                                currentEfficiency, proposedEfficiency,
-                                                nmax,
-                                                false,
-                                                ParallelDescriptor::IOProcessorNumber());
-        // As specified in the above calls to makeSFC and makeKnapSack, the new
+        if (load_balance_hierarchical)
+        {
+            if (m_node_of_rank.empty()) {
+                m_node_of_rank = HierarchicalDistributionMapping::GetNodeOfRanks(load_balance_ranks_per_node);
+            }
+
+            // Gather the costs of all boxes on root
+            Vector<Real> rcost(costs[lev]->size(), Real(0.));
+            for (const int i : costs[lev]->IndexArray()) { rcost[i] = (*costs[lev])[i]; }
+            ParallelDescriptor::ReduceRealSum(rcost.data(), static_cast<int>(rcost.size()),
+                                              ParallelDescriptor::IOProcessorNumber());
+
+            if (ParallelDescriptor::MyProc() == ParallelDescriptor::IOProcessorNumber())
+            {
+                newdm = HierarchicalDistributionMapping::MakeHierarchicalSFC(
+                    rcost, boxArray(lev), m_node_of_rank);
+
+                const Vector<int>& current_pmap = DistributionMap(lev).ProcessorMap();
+                const Vector<int>& proposed_pmap = newdm.ProcessorMap();
+                currentEfficiency = HierarchicalDistributionMapping::Efficiency(
+                    rcost, current_pmap, ParallelDescriptor::NProcs());
+                proposedEfficiency = HierarchicalDistributionMapping::Efficiency(
+                    rcost, proposed_pmap, ParallelDescriptor::NProcs());
+
+                if (verbose) {
+                    const auto current_volume = HierarchicalDistributionMapping::EstimateExchangeVolume(
+                        boxArray(lev), current_pmap, m_node_of_rank, guard_cells.ng_alloc_EB);
+                    const auto proposed_volume = HierarchicalDistributionMapping::EstimateExchangeVolume(
+                        boxArray(lev), proposed_pmap, m_node_of_rank, guard_cells.ng_alloc_EB);
+                    amrex::Print() << Utils::TextMsg::Info(
+                        "Hierarchical load balance on level " + std::to_string(lev)
+                        + ": efficiency " + std::to_string(currentEfficiency)
+                        + " -> " + std::to_string(proposedEfficiency)
+                        + ", guard cells exchanged between ranks "
+                        + std::to_string(current_volume.inter_rank_cells)
+                        + " -> " + std::to_string(proposed_volume.inter_rank_cells)
+                        + ", between nodes " + std::to_string(current_volume.inter_node_cells)
+                        + " -> " + std::to_string(proposed_volume.inter_node_cells));
+                }
+            }
+        }
+        else
+        {
+            newdm = (load_balance_with_sfc)
+                ? DistributionMapping::makeSFC(*costs[lev],
+                                               currentEfficiency, proposedEfficiency,
+                                               false,
+                                               ParallelDescriptor::IOProcessorNumber())
+                : DistributionMapping::makeKnapSack(*costs[lev],
+                                                    currentEfficiency, proposedEfficiency,
+                                                    nmax,
+                                                    false,
+                                                    ParallelDescriptor::IOProcessorNumber());
+        }
+        // As specified in the above calls to makeSFC and makeKnapSack (and for
+        // the hierarchical mapping), the new
         // distribution mapping is NOT communicated to all ranks; the loadbalanced
         // dm is up-to-date only on root, and we can decide whether to broadcast
         if ((load_balance_efficiency_ratio_threshold > 0.0)
@@ -578,7 +578,9 @@ LaserParticleContainer::Evolve (int lev,
         t_lab = 1._rt/WarpX::gamma_boost*t + WarpX::beta_boost*m_Z0_lab/PhysConst::c;
     }
 
-    // Update laser profile
+    // Update laser profile; some profiles only need their data
+    // on the ranks that own particles of the antenna
+    m_up_laser_profile->set_antenna_ownership(TotalNumberOfParticles(true, true) > 0);
     m_up_laser_profile->update(t_lab);
 
     BL_ASSERT(OnSameGrids(lev,jx));
@@ -869,18 +871,18 @@ LaserParticleContainer::update_laser_particle (WarpXParIter& pti,
 #if (AMREX_SPACEDIM >= 2)
     ParticleReal* x_n = nullptr;
     if (push_type == PushType::Implicit) {
-        x_n = pti.GetAttribs(particle_comps["x_n"]).dataPtr();
+        x_n = GetTransientRealComp("x_n", pti);
     }
 #endif
 #if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
     ParticleReal* y_n = nullptr;
     if (push_type == PushType::Implicit) {
-        y_n = pti.GetAttribs(particle_comps["y_n"]).dataPtr();
+        y_n = GetTransientRealComp("y_n", pti);
     }
 #endif
     ParticleReal* z_n = nullptr;
     if (push_type == PushType::Implicit) {
-        z_n = pti.GetAttribs(particle_comps["z_n"]).dataPtr();
+        z_n = GetTransientRealComp("z_n", pti);
     }
 
     // Copy member variables to tmp copies for GPU runs.
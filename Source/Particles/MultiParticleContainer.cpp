@@ -11,6 +11,7 @@
  */
 #include "MultiParticleContainer.H"
 
+#include "AcceleratorLattice/AcceleratorLattice.H"
 #include "FieldSolver/Fields.H"
 #include "Particles/ElementaryProcess/Ionization.H"
 #ifdef WARPX_QED
@@ -35,6 +36,7 @@
 #include "Particles/WarpXParticleContainer.H"
 #include "SpeciesPhysicalProperties.H"
 #include "Utils/Parser/ParserUtils.H"
+#include "Utils/TelemetryTimers.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
@@ -326,6 +328,15 @@ MultiParticleContainer::ReadParameters ()
 
         }
         pp_particles.query("use_fdtd_nci_corr", WarpX::use_fdtd_nci_corr);
+        pp_particles.query("do_fused_push", m_do_fused_push);
+        bool do_batched_redistribute = false;
+        pp_particles.query("do_batched_redistribute", do_batched_redistribute);
+        if (do_batched_redistribute) {
+#ifdef AMREX_USE_GPU
+            WARPX_ABORT_WITH_MESSAGE("particles.do_batched_redistribute is only available on CPU");
+#endif
+            m_neighbor_exchange = std::make_unique<NeighborParticleExchange>();
+        }
 #ifdef WARPX_DIM_RZ
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(WarpX::use_fdtd_nci_corr==0,
                             "ERROR: use_fdtd_nci_corr is not supported in RZ");
@@ -471,10 +482,124 @@ MultiParticleContainer::Evolve (int lev,
         if (rho) { rho->setVal(0.0); }
         if (crho) { crho->setVal(0.0); }
     }
+
+    // Species whose gather and push are fused (no buffers, explicit push only)
+    amrex::Vector<PhysicalParticleContainer*> fused_species;
+    if (m_do_fused_push && push_type == PushType::Explicit && !cEx && !cjx) {
+        fused_species = GetFusedPushSpecies(lev);
+    }
+
     for (auto& pc : allcontainers) {
+        if (std::find(fused_species.begin(), fused_species.end(), pc.get()) != fused_species.end()) {
+            continue;
+        }
         pc->Evolve(lev, Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz, cjx, cjy, cjz,
                    rho, crho, cEx, cEy, cEz, cBx, cBy, cBz, t, dt, a_dt_type, skip_deposition, push_type);
     }
+
+    if (!fused_species.empty()) {
+        EvolveFused(fused_species, lev, Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz, rho, dt, skip_deposition);
+    }
+}
+
+amrex::Vector<PhysicalParticleContainer*>
+MultiParticleContainer::GetFusedPushSpecies (const int lev)
+{
+    amrex::Vector<PhysicalParticleContainer*> fused_species;
+
+    // The external particle fields that are computed per particle and the NCI
+    // filter are only supported by the push of each species
+    auto& warpx = WarpX::GetInstance();
+    const auto gathered_or_constant = [] (const std::string& s) {
+        return s == "none" || s == "constant" || s == "read_from_file";
+    };
+    if (!gathered_or_constant(m_E_ext_particle_s) || !gathered_or_constant(m_B_ext_particle_s) ||
+        warpx.get_accelerator_lattice(lev).m_lattice_defined || WarpX::use_fdtd_nci_corr) {
+        return fused_species;
+    }
+
+    for (int i = 0; i < static_cast<int>(species_types.size()); ++i) {
+        if (species_types[i] != PCTypes::Physical) { continue; }
+        auto* pc = dynamic_cast<PhysicalParticleContainer*>(allcontainers[i].get());
+        if (pc && pc->CanFusePush()) { fused_species.push_back(pc); }
+    }
+
+    // Fusing a single species brings nothing
+    if (fused_species.size() < 2) { fused_species.clear(); }
+    return fused_species;
+}
+
+void
+MultiParticleContainer::EvolveFused (const amrex::Vector<PhysicalParticleContainer*>& species,
+                                     const int lev,
+                                     const MultiFab& Ex, const MultiFab& Ey, const MultiFab& Ez,
+                                     const MultiFab& Bx, const MultiFab& By, const MultiFab& Bz,
+                                     MultiFab& jx, MultiFab& jy, MultiFab& jz,
+                                     MultiFab* rho, const Real dt, const bool skip_deposition)
+{
+    WARPX_PROFILE("MultiParticleContainer::EvolveFused()");
+    WARPX_PROFILE_VAR_NS("MultiParticleContainer::EvolveFused::GatherAndPush", blp_fg);
+
+    // Deposit charge before particle push, in component 0 of rho
+    if (rho && !skip_deposition) {
+        for (auto* pc : species) {
+            pc->DepositForFusedPush(lev, jx, jy, jz, rho, dt, true);
+        }
+    }
+
+    // Gather and push all species of a tile in one kernel
+    WARPX_PROFILE_VAR_START(blp_fg);
+    const bool record_push_telemetry = telemetry::IsRecording();
+    if (record_push_telemetry) { telemetry::Start(telemetry::Category::Push); }
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    const WarpXParticleContainer& pc0 = *species[0];
+    const auto info = getMFItInfo(pc0);
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    {
+        amrex::Vector<FusedPushSpecies> table;
+        for (MFIter mfi(pc0.ParticleBoxArray(lev), pc0.ParticleDistributionMap(lev), info);
+             mfi.isValid(); ++mfi)
+        {
+            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            {
+                amrex::Gpu::synchronize();
+            }
+            auto wt = static_cast<amrex::Real>(amrex::second());
+
+            table.clear();
+            for (auto* pc : species) {
+                auto& particles_at_level = pc->GetParticles(lev);
+                const auto it = particles_at_level.find(std::make_pair(mfi.index(), mfi.LocalTileIndex()));
+                if (it == particles_at_level.end() || it->second.numParticles() == 0) { continue; }
+                table.push_back(pc->GetFusedPushSpecies(it->second));
+            }
+            if (table.empty()) { continue; }
+
+            PhysicalParticleContainer::PushPXFused(table,
+                Ex[mfi], Ey[mfi], Ez[mfi], Bx[mfi], By[mfi], Bz[mfi],
+                mfi.tilebox(), Ex.nGrowVect(), lev, dt);
+
+            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            {
+                wt = static_cast<amrex::Real>(amrex::second()) - wt;
+                amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            }
+        }
+    }
+
+    if (record_push_telemetry) { telemetry::Stop(); }
+    WARPX_PROFILE_VAR_STOP(blp_fg);
+
+    // Deposit current, and charge after particle push in component 1 of rho
+    if (!skip_deposition) {
+        for (auto* pc : species) {
+            pc->DepositForFusedPush(lev, jx, jy, jz, rho, dt, false);
+        }
+    }
 }
 
 void
@@ -566,12 +691,23 @@ MultiParticleContainer::DepositCharge (
     bool const reset = false;
     bool const apply_boundary_and_scale_volume = false;
     bool const interpolate_across_levels = false;
-    // Call the deposition kernel for each species
-    for (auto& pc : allcontainers)
+    if (WarpX::charge_deposition_algo == ChargeDepositionAlgo::Sorted)
     {
-        if (pc->do_not_deposit) { continue; }
-        pc->DepositCharge(rho, local, reset, apply_boundary_and_scale_volume,
-                              interpolate_across_levels);
+        // Deposit all species in one pass over the particle tiles
+        for (int lev = 0; lev < rho.size(); ++lev)
+        {
+            DepositChargeBatched(*rho[lev], lev);
+        }
+    }
+    else
+    {
+        // Call the deposition kernel for each species
+        for (auto& pc : allcontainers)
+        {
+            if (pc->do_not_deposit) { continue; }
+            pc->DepositCharge(rho, local, reset, apply_boundary_and_scale_volume,
+                                  interpolate_across_levels);
+        }
     }
 
     // Push the particles back in time
@@ -590,10 +726,21 @@ MultiParticleContainer::GetChargeDensity (int lev, bool local)
 {
     std::unique_ptr<MultiFab> rho = GetZeroChargeDensity(lev);
 
-    for (auto& container : allcontainers) {
-        if (container->do_not_deposit) { continue; }
-        const std::unique_ptr<MultiFab> rhoi = container->GetChargeDensity(lev, true);
-        MultiFab::Add(*rho, *rhoi, 0, 0, rho->nComp(), rho->nGrowVect());
+    if (WarpX::charge_deposition_algo == ChargeDepositionAlgo::Sorted) {
+        // Deposit all species in one pass over the particle tiles, then apply
+        // the (linear) volume scaling and boundary conditions once to the sum
+        DepositChargeBatched(*rho, lev);
+#ifdef WARPX_DIM_RZ
+        WarpX::GetInstance().ApplyInverseVolumeScalingToChargeDensity(rho.get(), lev);
+#else
+        WarpX::GetInstance().ApplyRhofieldBoundary(lev, rho.get(), PatchType::fine);
+#endif
+    } else {
+        for (auto& container : allcontainers) {
+            if (container->do_not_deposit) { continue; }
+            const std::unique_ptr<MultiFab> rhoi = container->GetChargeDensity(lev, true);
+            MultiFab::Add(*rho, *rhoi, 0, 0, rho->nComp(), rho->nGrowVect());
+        }
     }
     if (!local) {
         const Geometry& gm = allcontainers[0]->Geom(lev);
@@ -607,6 +754,61 @@ MultiParticleContainer::GetChargeDensity (int lev, bool local)
     return rho;
 }
 
+void
+MultiParticleContainer::DepositChargeBatched (amrex::MultiFab& rho, const int lev)
+{
+    WARPX_PROFILE("MultiParticleContainer::DepositChargeBatched");
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::Deposit);
+
+    // Species that deposit charge (photons and neutral species have no charge)
+    amrex::Vector<WarpXParticleContainer*> species;
+    for (auto& pc : allcontainers) {
+        if (pc->do_not_deposit || pc->getCharge() == 0._prt) { continue; }
+        species.push_back(pc.get());
+    }
+    if (species.empty()) { return; }
+
+    const WarpX& warpx = WarpX::GetInstance();
+    const amrex::IntVect& ng_rho = warpx.get_ng_depos_rho();
+    const amrex::IntVect ix_type = rho.ixType().toIntVect();
+    const int nc = WarpX::ncomps;
+
+    // All species use the same particle tiles, so that the tiles of an MFIter
+    // on the particle grids match the particle tiles of each species
+    const WarpXParticleContainer& pc0 = *species[0];
+    amrex::MFItInfo info;
+    if (WarpXParticleContainer::do_tiling) {
+        info.EnableTiling(WarpXParticleContainer::tile_size);
+    }
+#ifdef AMREX_USE_OMP
+    info.SetDynamic(true);
+#pragma omp parallel
+#endif
+    {
+        amrex::FArrayBox local_rho;
+        for (amrex::MFIter mfi(pc0.ParticleBoxArray(lev), pc0.ParticleDistributionMap(lev), info);
+             mfi.isValid(); ++mfi)
+        {
+            amrex::Box tilebox = mfi.tilebox();
+            tilebox.grow(ng_rho);
+            const amrex::Box tb = amrex::convert(tilebox, ix_type);
+
+            local_rho.resize(tb, nc);
+            local_rho.setVal(0.0);
+
+            bool has_particles = false;
+            for (auto* pc : species) {
+                has_particles |= pc->DepositChargeSortedOnTile(
+                    lev, mfi.index(), mfi.LocalTileIndex(), local_rho, tilebox);
+            }
+
+            if (has_particles) {
+                rho[mfi].lockAdd(local_rho, tb, tb, 0, 0, nc);
+            }
+        }
+    }
+}
+
 void
 MultiParticleContainer::SortParticlesByBin (amrex::IntVect bin_size)
 {
@@ -622,6 +824,7 @@ MultiParticleContainer::SortParticlesByBin (amrex::IntVect bin_size)
 void
 MultiParticleContainer::Redistribute ()
 {
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::Redistribute);
     for (auto& pc : allcontainers) {
         pc->Redistribute();
     }
@@ -646,9 +849,26 @@ MultiParticleContainer::deleteInvalidParticles ()
 void
 MultiParticleContainer::RedistributeLocal (const int num_ghost)
 {
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::Redistribute);
+    if (!m_neighbor_exchange || allcontainers.empty()) {
+        for (auto& pc : allcontainers) {
+            pc->Redistribute(0, 0, 0, num_ghost);
+        }
+        return;
+    }
+
+    // Species on the level-0 grids are exchanged together, the others separately
+    const auto& ba = allcontainers[0]->ParticleBoxArray(0);
+    const auto& dm = allcontainers[0]->ParticleDistributionMap(0);
+    amrex::Vector<WarpXParticleContainer*> batched;
     for (auto& pc : allcontainers) {
-        pc->Redistribute(0, 0, 0, num_ghost);
+        if (pc->finestLevel() == 0 && pc->ParticleBoxArray(0) == ba && pc->ParticleDistributionMap(0) == dm) {
+            batched.push_back(pc.get());
+        } else {
+            pc->Redistribute(0, 0, 0, num_ghost);
+        }
     }
+    m_neighbor_exchange->Redistribute(batched, num_ghost);
 }
 
 void
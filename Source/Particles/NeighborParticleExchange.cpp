@@ -0,0 +1,365 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "NeighborParticleExchange.H"
+
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXProfilerWrapper.H"
+
+#include <AMReX_Box.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Particle.H>
+#include <AMReX_ParticleUtil.H>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace amrex;
+
+namespace
+{
+    // Destination of a particle that leaves the rank or is removed
+    constexpr int local_slot = -1;
+    constexpr int removed_slot = -2;
+
+    /** Particle that leaves its tile */
+    struct Mover
+    {
+        Long index;
+        int grid;
+        int tile;
+        int slot; // index of the destination rank in the neighbor ranks, local_slot or removed_slot
+    };
+
+    /** Tile of a species, with the particles that leave it */
+    struct SpeciesTile
+    {
+        int species;
+        int grid;
+        int tile;
+        WarpXParticleContainer::ParticleTileType* ptile;
+        std::vector<Mover> movers;
+    };
+
+    template <typename T>
+    void AppendBytes (Vector<char>& buffer, const T* src, std::size_t n)
+    {
+        const std::size_t offset = buffer.size();
+        buffer.resize(offset + n*sizeof(T));
+        std::memcpy(buffer.data() + offset, src, n*sizeof(T));
+    }
+
+    template <typename T>
+    const char* ReadBytes (const char* src, T* dst, std::size_t n)
+    {
+        std::memcpy(dst, src, n*sizeof(T));
+        return src + n*sizeof(T);
+    }
+
+    /** Number of bytes of a packed particle of species pc, after the header */
+    std::size_t PayloadBytes (const WarpXParticleContainer& pc)
+    {
+        return pc.NumRealComps()*sizeof(ParticleReal) + pc.NumIntComps()*sizeof(int)
+            + sizeof(std::uint64_t);
+    }
+}
+
+NeighborParticleExchange::~NeighborParticleExchange ()
+{
+    FreeRequests();
+}
+
+void
+NeighborParticleExchange::FreeRequests ()
+{
+#ifdef AMREX_USE_MPI
+    if (m_count_requests.empty()) { return; }
+    int finalized = 0;
+    BL_MPI_REQUIRE( MPI_Finalized(&finalized) );
+    if (!finalized) {
+        for (auto& request : m_count_requests) {
+            if (request != MPI_REQUEST_NULL) { BL_MPI_REQUIRE( MPI_Request_free(&request) ); }
+        }
+    }
+    m_count_requests.clear();
+#endif
+}
+
+void
+NeighborParticleExchange::BuildPlan (const Geometry& geom, const BoxArray& ba,
+                                     const DistributionMapping& dm, const int num_ghost)
+{
+    WARPX_PROFILE("NeighborParticleExchange::BuildPlan()");
+
+    FreeRequests();
+    m_ba = ba;
+    m_dm = dm;
+    m_num_ghost = num_ghost;
+    m_neighbor_grids.clear();
+    m_neighbor_ranks.clear();
+    m_rank_slot.clear();
+
+    const int myproc = ParallelDescriptor::MyProc();
+    std::vector<std::pair<int, Box>> isects;
+    Vector<IntVect> pshifts;
+    std::set<int> ranks;
+    for (int i = 0; i < static_cast<int>(ba.size()); ++i) {
+        if (dm[i] != myproc) { continue; }
+        auto& neighbors = m_neighbor_grids[i];
+        const Box grown = amrex::grow(ba[i], num_ghost);
+        ba.intersections(grown, isects);
+        for (const auto& isect : isects) { neighbors.push_back(isect.first); }
+        // Boxes reached across periodic boundaries
+        geom.periodicShift(geom.Domain(), grown, pshifts);
+        for (const auto& shift : pshifts) {
+            ba.intersections(grown + shift, isects);
+            for (const auto& isect : isects) { neighbors.push_back(isect.first); }
+        }
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+        for (const int n : neighbors) {
+            if (dm[n] != myproc) { ranks.insert(dm[n]); }
+        }
+    }
+    m_neighbor_ranks.assign(ranks.begin(), ranks.end());
+    const int nneighbors = static_cast<int>(m_neighbor_ranks.size());
+    for (int n = 0; n < nneighbors; ++n) { m_rank_slot[m_neighbor_ranks[n]] = n; }
+
+    m_send_counts.assign(nneighbors, 0);
+    m_recv_counts.assign(nneighbors, 0);
+    m_send_buffers.resize(nneighbors);
+
+#ifdef AMREX_USE_MPI
+    // The neighbor relation is symmetric, so each rank posts the matching requests
+    m_count_tag = ParallelDescriptor::SeqNum();
+    m_payload_tag = ParallelDescriptor::SeqNum();
+    const MPI_Comm comm = ParallelDescriptor::Communicator();
+    const MPI_Datatype count_type = ParallelDescriptor::Mpi_typemap<Long>::type();
+    m_count_requests.resize(2*nneighbors, MPI_REQUEST_NULL);
+    for (int n = 0; n < nneighbors; ++n) {
+        BL_MPI_REQUIRE( MPI_Recv_init(&m_recv_counts[n], 1, count_type, m_neighbor_ranks[n],
+                                      m_count_tag, comm, &m_count_requests[n]) );
+        BL_MPI_REQUIRE( MPI_Send_init(&m_send_counts[n], 1, count_type, m_neighbor_ranks[n],
+                                      m_count_tag, comm, &m_count_requests[nneighbors + n]) );
+    }
+#endif
+}
+
+void
+NeighborParticleExchange::Redistribute (const Vector<WarpXParticleContainer*>& containers,
+                                        const int num_ghost)
+{
+    WARPX_PROFILE("NeighborParticleExchange::Redistribute()");
+
+    if (containers.empty()) { return; }
+
+    const int lev = 0;
+    const Geometry& geom = containers[0]->Geom(lev);
+    const BoxArray& ba = containers[0]->ParticleBoxArray(lev);
+    const DistributionMapping& dm = containers[0]->ParticleDistributionMap(lev);
+    if (num_ghost != m_num_ghost || ba != m_ba || dm != m_dm) {
+        BuildPlan(geom, ba, dm, num_ghost);
+    }
+
+    std::vector<SpeciesTile> tiles;
+    for (int is = 0; is < static_cast<int>(containers.size()); ++is) {
+        for (auto& kv : containers[is]->GetParticles(lev)) {
+            tiles.push_back({is, kv.first.first, kv.first.second, &kv.second, {}});
+        }
+    }
+
+    // Find the particles that leave their tile, and their destination
+    const int myproc = ParallelDescriptor::MyProc();
+    const auto plo = geom.ProbLoArray();
+    const auto phi = geom.ProbHiArray();
+    const auto dxi = geom.InvCellSizeArray();
+    const Box& domain = geom.Domain();
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int it = 0; it < static_cast<int>(tiles.size()); ++it) {
+        auto& st = tiles[it];
+        auto& soa = st.ptile->GetStructOfArrays();
+        const Long np = st.ptile->numParticles();
+        ParticleReal* AMREX_RESTRICT pos[AMREX_SPACEDIM];
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) { pos[d] = soa.GetRealData(d).data(); }
+        std::uint64_t* AMREX_RESTRICT idcpu = soa.GetIdCPUData().data();
+
+        const Box grid_box = ba[st.grid];
+        const auto& neighbors = m_neighbor_grids.at(st.grid);
+        Box tile_box; // box of the tile st.tile, known once a particle is found in it
+
+        for (Long i = 0; i < np; ++i) {
+            if (!ParticleIDWrapper{idcpu[i]}.is_valid()) { continue; }
+
+            IntVect cell;
+            bool left_domain = false;
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                cell[d] = static_cast<int>(std::floor((pos[d][i] - plo[d])*dxi[d])) + domain.smallEnd(d);
+                if (cell[d] >= domain.smallEnd(d) && cell[d] <= domain.bigEnd(d)) { continue; }
+                if (!geom.isPeriodic(d)) {
+                    left_domain = true;
+                    continue;
+                }
+                const ParticleReal shift = (cell[d] < domain.smallEnd(d)) ? phi[d] - plo[d] : plo[d] - phi[d];
+                pos[d][i] += shift;
+                cell[d] = std::clamp(
+                    static_cast<int>(std::floor((pos[d][i] - plo[d])*dxi[d])) + domain.smallEnd(d),
+                    domain.smallEnd(d), domain.bigEnd(d));
+            }
+            if (left_domain) {
+                st.movers.push_back({i, -1, -1, removed_slot});
+                continue;
+            }
+            if (tile_box.contains(cell)) { continue; }
+
+            int grid = -1;
+            if (grid_box.contains(cell)) {
+                grid = st.grid;
+            } else {
+                for (const int n : neighbors) {
+                    if (ba[n].contains(cell)) { grid = n; break; }
+                }
+            }
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(grid >= 0,
+                "particles.do_batched_redistribute: a particle moved by more than "
+                + std::to_string(num_ghost) + " cells in one step");
+
+            Box tbx;
+            const int tile = getTileIndex(cell, ba[grid], WarpXParticleContainer::do_tiling,
+                                          WarpXParticleContainer::tile_size, tbx);
+            if (grid == st.grid && tile == st.tile) {
+                tile_box = tbx;
+                continue;
+            }
+            const int slot = (dm[grid] == myproc) ? local_slot : m_rank_slot.at(dm[grid]);
+            st.movers.push_back({i, grid, tile, slot});
+        }
+    }
+
+    // Pack the particles that leave their tile, for all species together, and invalidate them
+    for (auto& buffer : m_send_buffers) { buffer.clear(); }
+    m_local_buffer.clear();
+    for (auto& st : tiles) {
+        if (st.movers.empty()) { continue; }
+        auto& soa = st.ptile->GetStructOfArrays();
+        const int nreal = containers[st.species]->NumRealComps();
+        const int nint = containers[st.species]->NumIntComps();
+        std::uint64_t* idcpu = soa.GetIdCPUData().data();
+        for (const auto& m : st.movers) {
+            if (m.slot != removed_slot) {
+                auto& buffer = (m.slot == local_slot) ? m_local_buffer : m_send_buffers[m.slot];
+                const std::array<int, 3> header = {st.species, m.grid, m.tile};
+                AppendBytes(buffer, header.data(), header.size());
+                for (int c = 0; c < nreal; ++c) { AppendBytes(buffer, soa.GetRealData(c).data() + m.index, 1); }
+                for (int c = 0; c < nint; ++c) { AppendBytes(buffer, soa.GetIntData(c).data() + m.index, 1); }
+                AppendBytes(buffer, idcpu + m.index, 1);
+            }
+            ParticleIDWrapper{idcpu[m.index]}.make_invalid();
+        }
+    }
+
+    // Exchange the sizes with the persistent requests, then the particles
+    Vector<Vector<char>> recv_buffers;
+#ifdef AMREX_USE_MPI
+    const int nneighbors = static_cast<int>(m_neighbor_ranks.size());
+    if (nneighbors > 0) {
+        for (int n = 0; n < nneighbors; ++n) {
+            m_send_counts[n] = static_cast<Long>(m_send_buffers[n].size());
+        }
+        BL_MPI_REQUIRE( MPI_Startall(2*nneighbors, m_count_requests.data()) );
+        BL_MPI_REQUIRE( MPI_Waitall(2*nneighbors, m_count_requests.data(), MPI_STATUSES_IGNORE) );
+
+        const MPI_Comm comm = ParallelDescriptor::Communicator();
+        recv_buffers.resize(nneighbors);
+        Vector<MPI_Request> requests;
+        requests.reserve(2*nneighbors);
+        for (int n = 0; n < nneighbors; ++n) {
+            if (m_recv_counts[n] == 0) { continue; }
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_recv_counts[n] <= std::numeric_limits<int>::max(),
+                "particles.do_batched_redistribute: message too large");
+            recv_buffers[n].resize(m_recv_counts[n]);
+            requests.push_back(MPI_REQUEST_NULL);
+            BL_MPI_REQUIRE( MPI_Irecv(recv_buffers[n].data(), static_cast<int>(m_recv_counts[n]), MPI_CHAR,
+                                      m_neighbor_ranks[n], m_payload_tag, comm, &requests.back()) );
+        }
+        for (int n = 0; n < nneighbors; ++n) {
+            if (m_send_counts[n] == 0) { continue; }
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_send_counts[n] <= std::numeric_limits<int>::max(),
+                "particles.do_batched_redistribute: message too large");
+            requests.push_back(MPI_REQUEST_NULL);
+            BL_MPI_REQUIRE( MPI_Isend(m_send_buffers[n].data(), static_cast<int>(m_send_counts[n]), MPI_CHAR,
+                                      m_neighbor_ranks[n], m_payload_tag, comm, &requests.back()) );
+        }
+        BL_MPI_REQUIRE( MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE) );
+    }
+#endif
+
+    Unpack(containers, m_local_buffer);
+    for (const auto& buffer : recv_buffers) { Unpack(containers, buffer); }
+
+    // Remove the particles that were moved, or that were already invalid
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int it = 0; it < static_cast<int>(tiles.size()); ++it) {
+        removeInvalidParticles(*tiles[it].ptile);
+    }
+}
+
+void
+NeighborParticleExchange::Unpack (const Vector<WarpXParticleContainer*>& containers,
+                                  const Vector<char>& buffer)
+{
+    using ParticleTileType = WarpXParticleContainer::ParticleTileType;
+
+    if (buffer.empty()) { return; }
+    const char* const begin = buffer.data();
+    const char* const end = begin + buffer.size();
+
+    // Number of particles received by each tile
+    std::map<std::array<int, 3>, Long> counts;
+    for (const char* p = begin; p < end;) {
+        std::array<int, 3> header{};
+        p = ReadBytes(p, header.data(), header.size());
+        ++counts[header];
+        p += PayloadBytes(*containers[header[0]]);
+    }
+
+    // Make room at the end of each tile
+    std::map<std::array<int, 3>, std::pair<ParticleTileType*, Long>> destinations;
+    for (const auto& [key, count] : counts) {
+        auto& ptile = containers[key[0]]->DefineAndReturnParticleTile(0, key[1], key[2]);
+        const Long old_size = ptile.numParticles();
+        ptile.resize(old_size + count);
+        destinations[key] = {&ptile, old_size};
+    }
+
+    for (const char* p = begin; p < end;) {
+        std::array<int, 3> header{};
+        p = ReadBytes(p, header.data(), header.size());
+        auto& [ptile, ip] = destinations[header];
+        auto& soa = ptile->GetStructOfArrays();
+        const int nreal = containers[header[0]]->NumRealComps();
+        const int nint = containers[header[0]]->NumIntComps();
+        for (int c = 0; c < nreal; ++c) { p = ReadBytes(p, soa.GetRealData(c).data() + ip, 1); }
+        for (int c = 0; c < nint; ++c) { p = ReadBytes(p, soa.GetIntData(c).data() + ip, 1); }
+        p = ReadBytes(p, soa.GetIdCPUData().data() + ip, 1);
+        ++ip;
+    }
+}
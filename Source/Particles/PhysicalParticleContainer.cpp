@@ -35,6 +35,8 @@
 #include "Utils/Parser/ParserUtils.H"
 #include "Utils/ParticleUtils.H"
 #include "Utils/Physics/IonizationEnergiesTable.H"
+#include "Utils/ScratchPool.H"
+#include "Utils/TelemetryTimers.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
@@ -1077,9 +1079,14 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
                           overlap_realbox.lo(1),
                           overlap_realbox.lo(2))};
 
-        // count the number of particles that each cell in overlap_box could add
-        Gpu::DeviceVector<amrex::Long> counts(overlap_box.numPts(), 0);
-        Gpu::DeviceVector<amrex::Long> offset(overlap_box.numPts());
+        // count the number of particles that each cell in overlap_box could add,
+        // in vectors borrowed from the scratch pool for the duration of the tile
+        auto& scratch_pool = WarpX::GetInstance().GetLongScratchPool();
+        auto counts_lease = scratch_pool.Borrow(overlap_box.numPts());
+        auto offset_lease = scratch_pool.Borrow(overlap_box.numPts());
+        Gpu::DeviceVector<amrex::Long>& counts = *counts_lease;
+        Gpu::DeviceVector<amrex::Long>& offset = *offset_lease;
+        counts.assign(counts.size(), 0);
         auto *pcounts = counts.data();
         const amrex::IntVect lrrfac = rrfac;
         Box fine_overlap_box; // default Box is NOT ok().
@@ -1652,9 +1659,14 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
                           overlap_realbox.lo(1),
                           overlap_realbox.lo(2))};
 
-        // count the number of particles that each cell in overlap_box could add
-        Gpu::DeviceVector<int> counts(overlap_box.numPts(), 0);
-        Gpu::DeviceVector<int> offset(overlap_box.numPts());
+        // count the number of particles that each cell in overlap_box could add,
+        // in vectors borrowed from the scratch pool for the duration of the tile
+        auto& scratch_pool = WarpX::GetInstance().GetIntScratchPool();
+        auto counts_lease = scratch_pool.Borrow(overlap_box.numPts());
+        auto offset_lease = scratch_pool.Borrow(overlap_box.numPts());
+        Gpu::DeviceVector<int>& counts = *counts_lease;
+        Gpu::DeviceVector<int>& offset = *offset_lease;
+        counts.assign(counts.size(), 0);
         auto *pcounts = counts.data();
         const amrex::IntVect lrrfac = rrfac;
         Box fine_overlap_box; // default Box is NOT ok().
@@ -2148,19 +2160,26 @@ PhysicalParticleContainer::Evolve (int lev,
                 // Gather and push for particles not in the buffer
                 //
                 WARPX_PROFILE_VAR_START(blp_fg);
+                const bool record_push_telemetry = telemetry::IsRecording();
+                if (record_push_telemetry) { telemetry::Start(telemetry::Category::Push); }
                 const auto np_to_push = np_gather;
                 const auto gather_lev = lev;
-                if (push_type == PushType::Explicit) {
-                    PushPX(pti, exfab, eyfab, ezfab,
-                           bxfab, byfab, bzfab,
-                           Ex.nGrowVect(), e_is_nodal,
-                           0, np_to_push, lev, gather_lev, dt, ScaleFields(false), a_dt_type);
-                } else if (push_type == PushType::Implicit) {
-                    ImplicitPushXP(pti, exfab, eyfab, ezfab,
+                // Tiles with many particles are pushed in chunks, shared between OpenMP threads
+                ParticleUtils::ForEachParticleChunk(0, np_to_push, WarpX::particle_chunk_size,
+                    [&] (long chunk_offset, long chunk_np, int /*chunk_thread*/)
+                    {
+                        if (push_type == PushType::Explicit) {
+                            PushPX(pti, exfab, eyfab, ezfab,
                                    bxfab, byfab, bzfab,
                                    Ex.nGrowVect(), e_is_nodal,
-                                   0, np_to_push, lev, gather_lev, dt, ScaleFields(false), a_dt_type);
-                }
+                                   chunk_offset, chunk_np, lev, gather_lev, dt, ScaleFields(false), a_dt_type);
+                        } else if (push_type == PushType::Implicit) {
+                            ImplicitPushXP(pti, exfab, eyfab, ezfab,
+                                           bxfab, byfab, bzfab,
+                                           Ex.nGrowVect(), e_is_nodal,
+                                           chunk_offset, chunk_np, lev, gather_lev, dt, ScaleFields(false), a_dt_type);
+                        }
+                    });
 
                 if (np_gather < np)
                 {
@@ -2207,6 +2226,7 @@ PhysicalParticleContainer::Evolve (int lev,
                 }
 
                 WARPX_PROFILE_VAR_STOP(blp_fg);
+                if (record_push_telemetry) { telemetry::Stop(); }
 
                 // Current Deposition
                 if (!skip_deposition)
@@ -2217,10 +2237,16 @@ PhysicalParticleContainer::Evolve (int lev,
                     const int* const AMREX_RESTRICT ion_lev = (do_field_ionization)?
                         pti.GetiAttribs(particle_icomps["ionizationLevel"]).dataPtr():nullptr;
 
-                    // Deposit inside domains
-                    DepositCurrent(pti, wp, uxp, uyp, uzp, ion_lev, &jx, &jy, &jz,
-                                   0, np_current, thread_num,
-                                   lev, lev, dt, relative_time, push_type);
+                    // Deposit inside domains. Tiles with many particles are deposited in chunks,
+                    // shared between OpenMP threads: each chunk is deposited in the current
+                    // buffer of the thread that executes it, which is then added to the tile.
+                    ParticleUtils::ForEachParticleChunk(0, np_current, WarpX::particle_chunk_size,
+                        [&] (long chunk_offset, long chunk_np, int chunk_thread)
+                        {
+                            DepositCurrent(pti, wp, uxp, uyp, uzp, ion_lev, &jx, &jy, &jz,
+                                           chunk_offset, chunk_np, chunk_thread,
+                                           lev, lev, dt, relative_time, push_type);
+                        });
 
                     if (has_buffer)
                     {
@@ -2972,6 +2998,241 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
     });
 }
 
+namespace
+{
+    /** Gives GetParticlePosition and SetParticlePosition access to the
+     *  (non-const) data of a particle tile, like a particle iterator */
+    struct ParticleTileRef
+    {
+        WarpXParticleContainer::ParticleTileType* m_ptile;
+
+        [[nodiscard]] auto& GetStructOfArrays () const { return m_ptile->GetStructOfArrays(); }
+    };
+}
+
+bool
+PhysicalParticleContainer::CanFusePush () const
+{
+    return !do_not_push && !do_splitting && !m_do_back_transformed_particles && !DoQED();
+}
+
+FusedPushSpecies
+PhysicalParticleContainer::GetFusedPushSpecies (ParticleTileType& ptile)
+{
+    const ParticleTileRef tile_ref{&ptile};
+    FusedPushSpecies fs(GetParticlePosition<PIdx>(tile_ref), SetParticlePosition<PIdx>(tile_ref));
+
+    auto& soa = ptile.GetStructOfArrays();
+    fs.ux = soa.GetRealData(PIdx::ux).dataPtr();
+    fs.uy = soa.GetRealData(PIdx::uy).dataPtr();
+    fs.uz = soa.GetRealData(PIdx::uz).dataPtr();
+    if (do_field_ionization) {
+        fs.ion_lev = soa.GetIntData(particle_icomps["ionizationLevel"]).dataPtr();
+    }
+    if (m_save_previous_position) {
+#if (AMREX_SPACEDIM >= 2)
+        fs.x_old = soa.GetRealData(particle_comps["prev_x"]).dataPtr();
+#endif
+#if defined(WARPX_DIM_3D)
+        fs.y_old = soa.GetRealData(particle_comps["prev_y"]).dataPtr();
+#endif
+        fs.z_old = soa.GetRealData(particle_comps["prev_z"]).dataPtr();
+    }
+    fs.q = this->charge;
+    fs.m = this->mass;
+    fs.Ex_external = m_E_external_particle[0];
+    fs.Ey_external = m_E_external_particle[1];
+    fs.Ez_external = m_E_external_particle[2];
+    fs.Bx_external = m_B_external_particle[0];
+    fs.By_external = m_B_external_particle[1];
+    fs.Bz_external = m_B_external_particle[2];
+    fs.do_crr = do_classical_radiation_reaction;
+    fs.do_not_gather = do_not_gather;
+    fs.np = ptile.numParticles();
+    return fs;
+}
+
+void
+PhysicalParticleContainer::PushPXFused (const amrex::Vector<FusedPushSpecies>& species,
+                                        amrex::FArrayBox const& exfab,
+                                        amrex::FArrayBox const& eyfab,
+                                        amrex::FArrayBox const& ezfab,
+                                        amrex::FArrayBox const& bxfab,
+                                        amrex::FArrayBox const& byfab,
+                                        amrex::FArrayBox const& bzfab,
+                                        const amrex::Box& tilebox,
+                                        const amrex::IntVect ngEB,
+                                        const int lev,
+                                        const amrex::Real dt)
+{
+    // Index of the first particle of each species in the fused loop
+    amrex::Vector<FusedPushSpecies> table = species;
+    long np_total = 0;
+    for (auto& fs : table) {
+        fs.start = np_total;
+        np_total += fs.np;
+    }
+    // If no particles, do not do anything
+    if (np_total == 0) { return; }
+
+    const amrex::Gpu::Buffer<FusedPushSpecies> table_buffer(table.data(), table.size());
+    const FusedPushSpecies* const AMREX_RESTRICT p_table = table_buffer.data();
+    const int nspecies = static_cast<int>(table.size());
+
+    // The gather setup below is shared by all species of the tile
+    const amrex::XDim3 dinv = WarpX::InvCellSize(lev);
+
+    // Box from which field is gathered, with guard cells
+    const Box box = amrex::grow(tilebox, ngEB);
+
+    // Lower corner of tile box physical domain
+    const amrex::XDim3 xyzmin = WarpX::LowerCorner(box, lev, 0._rt);
+
+    const Dim3 lo = lbound(box);
+
+    const bool galerkin_interpolation = WarpX::galerkin_interpolation;
+    const int nox = WarpX::nox;
+    const int n_rz_azimuthal_modes = WarpX::n_rz_azimuthal_modes;
+    const auto pusher_algo = WarpX::particle_pusher_algo;
+
+    amrex::Array4<const amrex::Real> const& ex_arr = exfab.array();
+    amrex::Array4<const amrex::Real> const& ey_arr = eyfab.array();
+    amrex::Array4<const amrex::Real> const& ez_arr = ezfab.array();
+    amrex::Array4<const amrex::Real> const& bx_arr = bxfab.array();
+    amrex::Array4<const amrex::Real> const& by_arr = byfab.array();
+    amrex::Array4<const amrex::Real> const& bz_arr = bzfab.array();
+
+    amrex::IndexType const ex_type = exfab.box().ixType();
+    amrex::IndexType const ey_type = eyfab.box().ixType();
+    amrex::IndexType const ez_type = ezfab.box().ixType();
+    amrex::IndexType const bx_type = bxfab.box().ixType();
+    amrex::IndexType const by_type = byfab.box().ixType();
+    amrex::IndexType const bz_type = bzfab.box().ixType();
+
+    // Particles of the same species are contiguous in the fused loop
+    amrex::ParallelFor(np_total, [=] AMREX_GPU_DEVICE (long i)
+    {
+        int is = 0;
+        while (is+1 < nspecies && i >= p_table[is+1].start) { ++is; }
+        const FusedPushSpecies& fs = p_table[is];
+        const long ip = i - fs.start;
+
+        amrex::ParticleReal xp, yp, zp;
+        fs.getPosition(ip, xp, yp, zp);
+
+        if (fs.z_old) {
+#if (AMREX_SPACEDIM >= 2)
+            fs.x_old[ip] = xp;
+#endif
+#if defined(WARPX_DIM_3D)
+            fs.y_old[ip] = yp;
+#endif
+            fs.z_old[ip] = zp;
+        }
+
+        amrex::ParticleReal Exp = fs.Ex_external;
+        amrex::ParticleReal Eyp = fs.Ey_external;
+        amrex::ParticleReal Ezp = fs.Ez_external;
+        amrex::ParticleReal Bxp = fs.Bx_external;
+        amrex::ParticleReal Byp = fs.By_external;
+        amrex::ParticleReal Bzp = fs.Bz_external;
+
+        if (!fs.do_not_gather) {
+            doGatherShapeN(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                           ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                           ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                           dinv, xyzmin, lo, n_rz_azimuthal_modes,
+                           nox, galerkin_interpolation);
+        }
+
+        doParticleMomentumPush<0>(fs.ux[ip], fs.uy[ip], fs.uz[ip],
+                                  Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                                  fs.ion_lev ? fs.ion_lev[ip] : 1,
+                                  fs.m, fs.q, pusher_algo, fs.do_crr,
+#ifdef WARPX_QED
+                                  0._rt,
+#endif
+                                  dt);
+
+        UpdatePosition(xp, yp, zp, fs.ux[ip], fs.uy[ip], fs.uz[ip], dt);
+        fs.setPosition(ip, xp, yp, zp);
+    });
+
+    // The table must stay allocated until the kernel is done
+    amrex::Gpu::streamSynchronize();
+}
+
+void
+PhysicalParticleContainer::DepositForFusedPush (const int lev,
+                                                amrex::MultiFab& jx, amrex::MultiFab& jy, amrex::MultiFab& jz,
+                                                amrex::MultiFab* rho, const amrex::Real dt,
+                                                const bool before_push)
+{
+    WARPX_PROFILE("PhysicalParticleContainer::DepositForFusedPush()");
+
+    if (do_not_deposit) { return; }
+    // Charge after the push is skipped for the electrostatic solver, as in Evolve
+    const bool deposit_rho = rho &&
+        (before_push || WarpX::electrostatic_solver_id == ElectrostaticSolverAlgo::None);
+    if (before_push && !deposit_rho) { return; }
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+    {
+#ifdef AMREX_USE_OMP
+        const int thread_num = omp_get_thread_num();
+#else
+        const int thread_num = 0;
+#endif
+        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+        {
+            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            {
+                amrex::Gpu::synchronize();
+            }
+            auto wt = static_cast<amrex::Real>(amrex::second());
+
+            auto& attribs = pti.GetAttribs();
+            auto&  wp = attribs[PIdx::w];
+            const long np = pti.numParticles();
+
+            const int* const AMREX_RESTRICT ion_lev = (do_field_ionization)?
+                pti.GetiAttribs(particle_icomps["ionizationLevel"]).dataPtr():nullptr;
+
+            if (!before_push) {
+                // Deposit at t_{n+1/2}, as with the explicit push of Evolve
+                const amrex::Real relative_time = -0.5_rt * dt;
+                ParticleUtils::ForEachParticleChunk(0, np, WarpX::particle_chunk_size,
+                    [&] (long chunk_offset, long chunk_np, int chunk_thread)
+                    {
+                        DepositCurrent(pti, wp, attribs[PIdx::ux], attribs[PIdx::uy], attribs[PIdx::uz],
+                                       ion_lev, &jx, &jy, &jz,
+                                       chunk_offset, chunk_np, chunk_thread,
+                                       lev, lev, dt, relative_time, PushType::Explicit);
+                    });
+            }
+
+            if (deposit_rho) {
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(before_push || rho->nComp() >= 2,
+                    "Cannot deposit charge in rho component 1: only component 0 is allocated!");
+                DepositCharge(pti, wp, ion_lev, rho, (before_push ? 0 : 1), 0,
+                              np, thread_num, lev, lev);
+            }
+
+            amrex::Gpu::synchronize();
+
+            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            {
+                wt = static_cast<amrex::Real>(amrex::second()) - wt;
+                amrex::HostDevice::Atomic::Add( &(*cost)[pti.index()], wt);
+            }
+        }
+    }
+}
+
 /* \brief Perform the implicit particle push operation in one fused kernel
  *        The main difference from PushPX is the order of operations:
  *         - push position by 1/2 dt
@@ -3057,15 +3318,15 @@ PhysicalParticleContainer::ImplicitPushXP (WarpXParIter& pti,
     ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr() + offset;
 
 #if (AMREX_SPACEDIM >= 2)
-    ParticleReal* x_n = pti.GetAttribs(particle_comps["x_n"]).dataPtr();
+    ParticleReal* x_n = GetTransientRealComp("x_n", pti);
 #endif
 #if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-    ParticleReal* y_n = pti.GetAttribs(particle_comps["y_n"]).dataPtr();
+    ParticleReal* y_n = GetTransientRealComp("y_n", pti);
 #endif
-    ParticleReal* z_n = pti.GetAttribs(particle_comps["z_n"]).dataPtr();
-    ParticleReal* ux_n = pti.GetAttribs(particle_comps["ux_n"]).dataPtr();
-    ParticleReal* uy_n = pti.GetAttribs(particle_comps["uy_n"]).dataPtr();
-    ParticleReal* uz_n = pti.GetAttribs(particle_comps["uz_n"]).dataPtr();
+    ParticleReal* z_n = GetTransientRealComp("z_n", pti);
+    ParticleReal* ux_n = GetTransientRealComp("ux_n", pti);
+    ParticleReal* uy_n = GetTransientRealComp("uy_n", pti);
+    ParticleReal* uz_n = GetTransientRealComp("uz_n", pti);
 
     const int do_copy = (m_do_back_transformed_particles && (a_dt_type!=DtType::SecondHalf) );
     CopyParticleAttribs copyAttribs;
@@ -9,6 +9,9 @@
 
 #include "VelocityCoincidenceThinning.H"
 
+#include "Utils/ScratchPool.H"
+#include "WarpX.H"
+
 
 VelocityCoincidenceThinning::VelocityCoincidenceThinning (const std::string& species_name)
 {
@@ -101,13 +104,13 @@ void VelocityCoincidenceThinning::operator() (WarpXParIter& pti, const int lev,
         "VelocityCoincidenceThinning does not yet work for massless particles."
     );
 
-    // create a GPU vector to hold the momentum cluster index for each particle
-    amrex::Gpu::DeviceVector<int> momentum_bin_number(n_parts_in_tile);
-    auto* momentum_bin_number_data = momentum_bin_number.data();
-
-    // create a GPU vector to hold the index sorting for the momentum bins
-    amrex::Gpu::DeviceVector<int> sorted_indices(n_parts_in_tile);
-    auto* sorted_indices_data = sorted_indices.data();
+    // borrow GPU vectors from the scratch pool, to hold the momentum cluster index
+    // for each particle and the index sorting for the momentum bins
+    auto& scratch_pool = WarpX::GetInstance().GetIntScratchPool();
+    auto momentum_bin_number_lease = scratch_pool.Borrow(n_parts_in_tile);
+    auto sorted_indices_lease = scratch_pool.Borrow(n_parts_in_tile);
+    auto* momentum_bin_number_data = momentum_bin_number_lease->data();
+    auto* sorted_indices_data = sorted_indices_lease->data();
 
     constexpr auto c2 = PhysConst::c * PhysConst::c;
 
@@ -323,4 +326,7 @@ void VelocityCoincidenceThinning::operator() (WarpXParIter& pti, const int lev,
             }
         }
     );
+
+    // the scratch vectors are given back to the pool when the leases go out of scope
+    amrex::Gpu::streamSynchronize();
 }
@@ -7,14 +7,18 @@
 #include "Particles/PhysicalParticleContainer.H"
 #include "Particles/WarpXParticleContainer.H"
 #include "SortingUtils.H"
+#include "Utils/ScratchPool.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
 
 #include <AMReX_GpuContainers.H>
 #include <AMReX_GpuDevice.H>
 #include <AMReX_GpuLaunch.H>
+#include <AMReX_ParticleTransformation.H>
 #include <AMReX_Particles.H>
 #include <AMReX_REAL.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_Scan.H>
 #include <AMReX_StructOfArrays.H>
 
 #include <AMReX_BaseFwd.H>
@@ -23,6 +27,60 @@
 
 using namespace amrex;
 
+namespace
+{
+    /* \brief Reorder, in place, the particles of `ptile` with index in [begin, end),
+     *        so that the particles for which `flag` is 0 come first
+     *
+     * Only the particles that are on the wrong side of the partition are moved:
+     * each of them is swapped with a particle on the other side. The order of
+     * the particles is thus not preserved.
+     *
+     * \return the index of the first particle for which `flag` is not 0
+     */
+    long partitionInPlace (WarpXParticleContainer::ParticleTileType& ptile,
+                           Gpu::DeviceVector<int> const& flag,
+                           long const begin, long const end,
+                           ScratchPool<int>& scratch_pool)
+    {
+        int const* AMREX_RESTRICT flag_ptr = flag.dataPtr();
+
+        // Number of particles that belong to the first part
+        long const n_first = Reduce::Sum<long>(end - begin,
+            [=] AMREX_GPU_DEVICE (long i) -> long { return (flag_ptr[begin+i] == 0) ? 1 : 0; });
+        long const sep = begin + n_first;
+
+        // Indices of the particles in the first part that belong to the second part, and conversely
+        auto misplaced_first_lease = scratch_pool.Borrow(n_first);
+        auto misplaced_second_lease = scratch_pool.Borrow(end - sep);
+        int* AMREX_RESTRICT misplaced_first = misplaced_first_lease->dataPtr();
+        int* AMREX_RESTRICT misplaced_second = misplaced_second_lease->dataPtr();
+        int const n_misplaced = Scan::PrefixSum<int>(static_cast<int>(n_first),
+            [=] AMREX_GPU_DEVICE (int i) -> int { return (flag_ptr[begin+i] != 0) ? 1 : 0; },
+            [=] AMREX_GPU_DEVICE (int i, int const& s) {
+                if (flag_ptr[begin+i] != 0) { misplaced_first[s] = static_cast<int>(begin+i); }
+            },
+            Scan::Type::exclusive, Scan::retSum);
+        Scan::PrefixSum<int>(static_cast<int>(end - sep),
+            [=] AMREX_GPU_DEVICE (int i) -> int { return (flag_ptr[sep+i] == 0) ? 1 : 0; },
+            [=] AMREX_GPU_DEVICE (int i, int const& s) {
+                if (flag_ptr[sep+i] == 0) { misplaced_second[s] = static_cast<int>(sep+i); }
+            },
+            Scan::Type::exclusive, Scan::noRetSum);
+
+        if (n_misplaced > 0) {
+            auto ptd = ptile.getParticleTileData();
+            amrex::ParallelFor(n_misplaced, [=] AMREX_GPU_DEVICE (int k) {
+                amrex::swapParticle(ptd, ptd, misplaced_first[k], misplaced_second[k]);
+            });
+        }
+        // Make sure that the kernels finish before the temporary arrays are given back
+        Gpu::streamSynchronize();
+
+        return sep;
+    }
+}
+
 /* \brief Determine which particles deposit/gather in the buffer, and
  *        and reorder the particle arrays accordingly
  *
@@ -57,11 +115,12 @@ PhysicalParticleContainer::PartitionParticlesInBuffers(
 {
     WARPX_PROFILE("PhysicalParticleContainer::PartitionParticlesInBuffers");
 
-    // Initialize temporary arrays
-    Gpu::DeviceVector<int> inexflag;
-    inexflag.resize(np);
-    Gpu::DeviceVector<int> pid;
-    pid.resize(np);
+    // Initialize temporary arrays, reusing memory from the previous calls
+    auto& scratch_pool = WarpX::GetInstance().GetIntScratchPool();
+    auto inexflag_lease = scratch_pool.Borrow(np);
+    auto pid_lease = scratch_pool.Borrow(np);
+    Gpu::DeviceVector<int>& inexflag = *inexflag_lease;
+    Gpu::DeviceVector<int>& pid = *pid_lease;
 
     // First, partition particles into the larger buffer
 
@@ -75,12 +134,20 @@ PhysicalParticleContainer::PartitionParticlesInBuffers(
     // - Find the indices that reorder particles so that the last particles
     //   are in the larger buffer
     fillWithConsecutiveIntegers( pid );
-    auto *const sep = stablePartition( pid.begin(), pid.end(), inexflag );
-    // At the end of this step, `pid` contains the indices that should be used to
-    // reorder the particles, and `sep` is the position in the array that
-    // separates the particles that deposit/gather on the fine patch (first part)
-    // and the particles that deposit/gather in the buffers (last part)
-    long const n_fine = iteratorDistance(pid.begin(), sep);
+    int* sep = pid.end();
+    long n_fine = 0;
+    if (WarpX::incremental_buffer_partition) {
+        // Reorder the particles directly, moving only those that
+        // entered or left the buffer since the last step
+        n_fine = partitionInPlace(pti.GetParticleTile(), inexflag, 0, np, scratch_pool);
+    } else {
+        sep = stablePartition( pid.begin(), pid.end(), inexflag );
+        // At the end of this step, `pid` contains the indices that should be used to
+        // reorder the particles, and `sep` is the position in the array that
+        // separates the particles that deposit/gather on the fine patch (first part)
+        // and the particles that deposit/gather in the buffers (last part)
+        n_fine = iteratorDistance(pid.begin(), sep);
+    }
     // Number of particles on fine patch, i.e. outside of the larger buffer
 
     // Second, among particles that are in the larger buffer, partition
@@ -88,8 +155,8 @@ PhysicalParticleContainer::PartitionParticlesInBuffers(
 
     if (WarpX::n_current_deposition_buffer == WarpX::n_field_gather_buffer) {
         // No need to do anything if the buffers have the same size
-        nfine_current = nfine_gather = iteratorDistance(pid.begin(), sep);
-    } else if (sep == pid.end()) {
+        nfine_current = nfine_gather = n_fine;
+    } else if (n_fine == np) {
         // No need to do anything if there are no particles in the larger buffer
         nfine_current = nfine_gather = np;
     } else {
@@ -107,14 +174,21 @@ PhysicalParticleContainer::PartitionParticlesInBuffers(
         {
             // - For each particle in the large buffer, find whether it is in
             // the smaller buffer, by looking up the mask. Store the answer in `inexflag`.
+            // (With the incremental partition, `pid` is the identity.)
             amrex::ParallelFor( np - n_fine,
                fillBufferFlagRemainingParticles(pti, bmasks, inexflag, Geom(lev), pid, int(n_fine)) );
-            auto *const sep2 = stablePartition( sep, pid.end(), inexflag );
+            long n_fine2 = 0;
+            if (WarpX::incremental_buffer_partition) {
+                n_fine2 = partitionInPlace(pti.GetParticleTile(), inexflag, n_fine, np, scratch_pool);
+            } else {
+                auto *const sep2 = stablePartition( sep, pid.end(), inexflag );
+                n_fine2 = iteratorDistance(pid.begin(), sep2);
+            }
 
             if (bmasks == gather_masks) {
-                nfine_gather = iteratorDistance(pid.begin(), sep2);
+                nfine_gather = n_fine2;
             } else {
-                nfine_current = iteratorDistance(pid.begin(), sep2);
+                nfine_current = n_fine2;
             }
         }
     }
@@ -128,7 +202,8 @@ PhysicalParticleContainer::PartitionParticlesInBuffers(
     }
 
     // Reorder the actual particle array, using the `pid` indices
-    if (nfine_current != np || nfine_gather != np)
+    // (with the incremental partition, the particles were already reordered)
+    if (!WarpX::incremental_buffer_partition && (nfine_current != np || nfine_gather != np))
     {
         // Prepare temporary particle tile to copy to
         ParticleTileType ptile_tmp;
@@ -16,6 +16,7 @@
 #include "Pusher/GetAndSetPosition.H"
 #include "Pusher/UpdatePosition.H"
 #include "ParticleBoundaries_K.H"
+#include "Utils/TelemetryTimers.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
@@ -351,6 +352,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                                         int const thread_num, const int lev, int const depos_lev,
                                         amrex::Real const dt, amrex::Real const relative_time, PushType push_type)
 {
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::Deposit);
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE((depos_lev==(lev-1)) ||
                                      (depos_lev==(lev  )),
                                      "Deposition buffers only work for lev-1");
@@ -604,27 +606,24 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                 }
             } else if (push_type == PushType::Implicit) {
 #if (AMREX_SPACEDIM >= 2)
-                auto& xp_n = pti.GetAttribs(particle_comps["x_n"]);
-                const ParticleReal* xp_n_data = xp_n.dataPtr() + offset;
+                const ParticleReal* xp_n_data = GetTransientRealComp("x_n", pti) + offset;
 #else
                 const ParticleReal* xp_n_data = nullptr;
 #endif
 #if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-                auto& yp_n = pti.GetAttribs(particle_comps["y_n"]);
-                const ParticleReal* yp_n_data = yp_n.dataPtr() + offset;
+                const ParticleReal* yp_n_data = GetTransientRealComp("y_n", pti) + offset;
 #else
                 const ParticleReal* yp_n_data = nullptr;
 #endif
-                auto& zp_n = pti.GetAttribs(particle_comps["z_n"]);
-                const ParticleReal* zp_n_data = zp_n.dataPtr() + offset;
-                auto& uxp_n = pti.GetAttribs(particle_comps["ux_n"]);
-                auto& uyp_n = pti.GetAttribs(particle_comps["uy_n"]);
-                auto& uzp_n = pti.GetAttribs(particle_comps["uz_n"]);
+                const ParticleReal* zp_n_data = GetTransientRealComp("z_n", pti) + offset;
+                const ParticleReal* uxp_n = GetTransientRealComp("ux_n", pti);
+                const ParticleReal* uyp_n = GetTransientRealComp("uy_n", pti);
+                const ParticleReal* uzp_n = GetTransientRealComp("uz_n", pti);
                 if        (WarpX::nox == 1){
                     doChargeConservingDepositionShapeNImplicit<1>(
                         xp_n_data, yp_n_data, zp_n_data,
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n + offset, uyp_n + offset, uzp_n + offset,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
                         jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dinv, xyzmin, lo, q,
                         WarpX::n_rz_azimuthal_modes);
@@ -632,7 +631,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                     doChargeConservingDepositionShapeNImplicit<2>(
                         xp_n_data, yp_n_data, zp_n_data,
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n + offset, uyp_n + offset, uzp_n + offset,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
                         jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dinv, xyzmin, lo, q,
                         WarpX::n_rz_azimuthal_modes);
@@ -640,7 +639,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                     doChargeConservingDepositionShapeNImplicit<3>(
                         xp_n_data, yp_n_data, zp_n_data,
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n + offset, uyp_n + offset, uzp_n + offset,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
                         jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dinv, xyzmin, lo, q,
                         WarpX::n_rz_azimuthal_modes);
@@ -648,7 +647,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                     doChargeConservingDepositionShapeNImplicit<4>(
                         xp_n_data, yp_n_data, zp_n_data,
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n + offset, uyp_n + offset, uzp_n + offset,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
                         jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dinv, xyzmin, lo, q,
                         WarpX::n_rz_azimuthal_modes);
@@ -657,27 +656,24 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
         } else if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Villasenor) {
             if (push_type == PushType::Implicit) {
 #if (AMREX_SPACEDIM >= 2)
-                auto& xp_n = pti.GetAttribs(particle_comps["x_n"]);
-                const ParticleReal* xp_n_data = xp_n.dataPtr() + offset;
+                const ParticleReal* xp_n_data = GetTransientRealComp("x_n", pti) + offset;
 #else
                 const ParticleReal* xp_n_data = nullptr;
 #endif
 #if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-                auto& yp_n = pti.GetAttribs(particle_comps["y_n"]);
-                const ParticleReal* yp_n_data = yp_n.dataPtr() + offset;
+                const ParticleReal* yp_n_data = GetTransientRealComp("y_n", pti) + offset;
 #else
                 const ParticleReal* yp_n_data = nullptr;
 #endif
-                auto& zp_n = pti.GetAttribs(particle_comps["z_n"]);
-                const ParticleReal* zp_n_data = zp_n.dataPtr() + offset;
-                auto& uxp_n = pti.GetAttribs(particle_comps["ux_n"]);
-                auto& uyp_n = pti.GetAttribs(particle_comps["uy_n"]);
-                auto& uzp_n = pti.GetAttribs(particle_comps["uz_n"]);
+                const ParticleReal* zp_n_data = GetTransientRealComp("z_n", pti) + offset;
+                const ParticleReal* uxp_n = GetTransientRealComp("ux_n", pti);
+                const ParticleReal* uyp_n = GetTransientRealComp("uy_n", pti);
+                const ParticleReal* uzp_n = GetTransientRealComp("uz_n", pti);
                 if (WarpX::nox == 1){
                     doVillasenorDepositionShapeNImplicit<1>(
                         xp_n_data, yp_n_data, zp_n_data,
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n + offset, uyp_n + offset, uzp_n + offset,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
                         jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dinv, xyzmin, lo, q,
                         WarpX::n_rz_azimuthal_modes);
@@ -685,7 +681,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                     doVillasenorDepositionShapeNImplicit<2>(
                         xp_n_data, yp_n_data, zp_n_data,
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n + offset, uyp_n + offset, uzp_n + offset,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
                         jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dinv, xyzmin, lo, q,
                         WarpX::n_rz_azimuthal_modes);
@@ -693,7 +689,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                     doVillasenorDepositionShapeNImplicit<3>(
                         xp_n_data, yp_n_data, zp_n_data,
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n + offset, uyp_n + offset, uzp_n + offset,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
                         jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dinv, xyzmin, lo, q,
                         WarpX::n_rz_azimuthal_modes);
@@ -701,7 +697,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                     doVillasenorDepositionShapeNImplicit<4>(
                         xp_n_data, yp_n_data, zp_n_data,
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n + offset, uyp_n + offset, uzp_n + offset,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
                         jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dinv, xyzmin, lo, q,
                         WarpX::n_rz_azimuthal_modes);
@@ -767,13 +763,13 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                         xyzmin, lo, q, WarpX::n_rz_azimuthal_modes);
                 }
             } else if (push_type == PushType::Implicit) {
-                auto& uxp_n = pti.GetAttribs(particle_comps["ux_n"]);
-                auto& uyp_n = pti.GetAttribs(particle_comps["uy_n"]);
-                auto& uzp_n = pti.GetAttribs(particle_comps["uz_n"]);
+                const ParticleReal* uxp_n = GetTransientRealComp("ux_n", pti);
+                const ParticleReal* uyp_n = GetTransientRealComp("uy_n", pti);
+                const ParticleReal* uzp_n = GetTransientRealComp("uz_n", pti);
                 if        (WarpX::nox == 1){
                     doDepositionShapeNImplicit<1>(
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n + offset, uyp_n + offset, uzp_n + offset,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset,
                         ion_lev,
                         jx_fab, jy_fab, jz_fab, np_to_deposit, dinv,
@@ -781,7 +777,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                 } else if (WarpX::nox == 2){
                     doDepositionShapeNImplicit<2>(
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n + offset, uyp_n + offset, uzp_n + offset,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset,
                         ion_lev,
                         jx_fab, jy_fab, jz_fab, np_to_deposit, dinv,
@@ -789,7 +785,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                 } else if (WarpX::nox == 3){
                     doDepositionShapeNImplicit<3>(
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n + offset, uyp_n + offset, uzp_n + offset,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset,
                         ion_lev,
                         jx_fab, jy_fab, jz_fab, np_to_deposit, dinv,
@@ -797,7 +793,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                 } else if (WarpX::nox == 4){
                     doDepositionShapeNImplicit<4>(
                         GetPosition, wp.dataPtr() + offset,
-                        uxp_n.dataPtr() + offset, uyp_n.dataPtr() + offset, uzp_n.dataPtr() + offset,
+                        uxp_n + offset, uyp_n + offset, uzp_n + offset,
                         uxp.dataPtr() + offset, uyp.dataPtr() + offset, uzp.dataPtr() + offset,
                         ion_lev,
                         jx_fab, jy_fab, jz_fab, np_to_deposit, dinv,
@@ -884,6 +880,7 @@ WarpXParticleContainer::DepositCharge (WarpXParIter& pti, RealVector const& wp,
                                        const long offset, const long np_to_deposit,
                                        const int thread_num, const int lev, const int depos_lev)
 {
+    const telemetry::ScopedTimer telemetry_timer(telemetry::Category::Deposit);
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
         rho->nComp() >= icomp - 1,
         "Cannot deposit charge in rho component icomp=" + std::to_string(icomp) +
@@ -1156,6 +1153,31 @@ WarpXParticleContainer::DepositCharge (WarpXParIter& pti, RealVector const& wp,
         AMREX_ALWAYS_ASSERT(WarpX::nox == WarpX::noy);
         AMREX_ALWAYS_ASSERT(WarpX::nox == WarpX::noz);
 
+        if (WarpX::charge_deposition_algo == ChargeDepositionAlgo::Sorted)
+        {
+            // If no particles, do not do anything
+            if (np_to_deposit == 0) { return; }
+
+            WARPX_PROFILE_VAR_NS("WarpXParticleContainer::DepositCharge::ChargeDeposition", blp_ppc_chd);
+            WARPX_PROFILE_VAR_NS("WarpXParticleContainer::DepositCharge::Accumulate", blp_accumulate);
+
+            // CPU only: particles deposit on the tile array local_rho[thread_num]
+            const amrex::Box tb = amrex::convert(tilebox, rho->ixType().toIntVect());
+            local_rho[thread_num].resize(tb, nc);
+            local_rho[thread_num].setVal(0.0);
+
+            WARPX_PROFILE_VAR_START(blp_ppc_chd);
+            DepositChargeSorted(pti.GetParticleTile(), wp.dataPtr(), ion_lev,
+                                local_rho[thread_num], tilebox, offset, np_to_deposit,
+                                depos_lev, time_shift_delta);
+            WARPX_PROFILE_VAR_STOP(blp_ppc_chd);
+
+            WARPX_PROFILE_VAR_START(blp_accumulate);
+            (*rho)[pti].lockAdd(local_rho[thread_num], tb, tb, 0, icomp*nc, nc);
+            WARPX_PROFILE_VAR_STOP(blp_accumulate);
+            return;
+        }
+
         ablastr::particles::deposit_charge<WarpXParticleContainer>(
                 pti, wp, this->charge, ion_lev,
                 rho, local_rho[thread_num],
@@ -1166,6 +1188,70 @@ WarpXParticleContainer::DepositCharge (WarpXParIter& pti, RealVector const& wp,
     }
 }
 
+void
+WarpXParticleContainer::DepositChargeSorted (const ParticleTileType& ptile,
+                                             const amrex::ParticleReal* wp,
+                                             const int* ion_lev,
+                                             amrex::FArrayBox& rho_fab,
+                                             const amrex::Box& tilebox,
+                                             const long offset,
+                                             const long np_to_deposit,
+                                             const int depos_lev,
+                                             const amrex::Real time_shift_delta) const
+{
+    // Lower corner of tile box physical domain (including guard cells)
+    const amrex::XDim3 xyzmin = WarpX::LowerCorner(tilebox, depos_lev, time_shift_delta);
+    const amrex::XDim3 dinv = WarpX::InvCellSize(std::max(depos_lev,0));
+
+    // Indices of the lower bound
+    const amrex::Dim3 lo = lbound(tilebox);
+
+    const auto GetPosition = GetParticlePosition<PIdx>(ptile, offset);
+    const amrex::ParticleReal* const wp_offset = wp + offset;
+    const int* const ion_lev_offset = (ion_lev) ? ion_lev + offset : nullptr;
+    const amrex::Real q = this->charge;
+
+    if        (WarpX::nox == 1){
+        doChargeDepositionSortedShapeN<1>(GetPosition, wp_offset, ion_lev_offset,
+                                          rho_fab, np_to_deposit, dinv, xyzmin, lo, q,
+                                          WarpX::n_rz_azimuthal_modes);
+    } else if (WarpX::nox == 2){
+        doChargeDepositionSortedShapeN<2>(GetPosition, wp_offset, ion_lev_offset,
+                                          rho_fab, np_to_deposit, dinv, xyzmin, lo, q,
+                                          WarpX::n_rz_azimuthal_modes);
+    } else if (WarpX::nox == 3){
+        doChargeDepositionSortedShapeN<3>(GetPosition, wp_offset, ion_lev_offset,
+                                          rho_fab, np_to_deposit, dinv, xyzmin, lo, q,
+                                          WarpX::n_rz_azimuthal_modes);
+    } else if (WarpX::nox == 4){
+        doChargeDepositionSortedShapeN<4>(GetPosition, wp_offset, ion_lev_offset,
+                                          rho_fab, np_to_deposit, dinv, xyzmin, lo, q,
+                                          WarpX::n_rz_azimuthal_modes);
+    }
+}
+
+bool
+WarpXParticleContainer::DepositChargeSortedOnTile (const int lev, const int grid, const int tile,
+                                                   amrex::FArrayBox& rho_fab,
+                                                   const amrex::Box& tilebox)
+{
+    auto& particles_at_level = GetParticles(lev);
+    const auto it = particles_at_level.find(std::make_pair(grid, tile));
+    if (it == particles_at_level.end()) { return false; }
+
+    const auto& ptile = it->second;
+    const long np = ptile.numParticles();
+    if (np == 0) { return false; }
+
+    const auto& soa = ptile.GetStructOfArrays();
+    const amrex::ParticleReal* const wp = soa.GetRealData(PIdx::w).dataPtr();
+    const int* const ion_lev = (do_field_ionization) ?
+        soa.GetIntData(particle_icomps["ionizationLevel"]).dataPtr() : nullptr;
+
+    DepositChargeSorted(ptile, wp, ion_lev, rho_fab, tilebox, 0, np, lev, 0.0_rt);
+    return true;
+}
+
 void
 WarpXParticleContainer::DepositCharge (amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
                                        const bool local, const bool reset,
@@ -1532,6 +1618,46 @@ void WarpXParticleContainer::defineAllParticleTiles () noexcept
     }
 }
 
+void
+WarpXParticleContainer::AllocateTransientRealComp (const std::string& name)
+{
+    auto& data = m_transient_real_comps[name];
+    data.resize(finestLevel()+1);
+    for (int lev = 0; lev <= finestLevel(); ++lev)
+    {
+        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+        {
+            const auto index = std::make_pair(pti.index(), pti.LocalTileIndex());
+            data[lev][index].resize(pti.numParticles());
+        }
+    }
+}
+
+void
+WarpXParticleContainer::ReleaseTransientRealComp (const std::string& name)
+{
+    // Erasing the entry frees the device memory of all tiles
+    m_transient_real_comps.erase(name);
+}
+
+bool
+WarpXParticleContainer::IsTransientRealCompAllocated (const std::string& name) const
+{
+    return m_transient_real_comps.find(name) != m_transient_real_comps.end();
+}
+
+amrex::ParticleReal*
+WarpXParticleContainer::GetTransientRealComp (const std::string& name, const WarpXParIter& pti)
+{
+    // Only look up existing entries, so that this can be called by several OpenMP threads
+    const auto search = m_transient_real_comps.find(name);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(search != m_transient_real_comps.end(),
+        "The transient particle attribute " + name + " is not allocated");
+    auto& tile_data = search->second[pti.GetLevel()].at(std::make_pair(pti.index(), pti.LocalTileIndex()));
+    AMREX_ASSERT(static_cast<long>(tile_data.size()) >= pti.numParticles());
+    return tile_data.dataPtr();
+}
+
 // This function is called in Redistribute, just after locate
 void
 WarpXParticleContainer::particlePostLocate(ParticleType& p,
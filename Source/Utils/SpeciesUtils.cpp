@@ -102,8 +102,19 @@ namespace SpeciesUtils {
             // Construct InjectorDensity with InjectorDensityParser.
             density_parser = std::make_unique<amrex::Parser>(
                 utils::parser::makeParser(str_density_function,{"x","y","z"}));
-            h_inj_rho.reset(new InjectorDensity((InjectorDensityParser*)nullptr,
-                density_parser->compile<3>()));
+            std::string density_table = "none";
+            utils::parser::query(pp_species, source_name, "density_table", density_table);
+            std::transform(density_table.begin(), density_table.end(),
+                           density_table.begin(), ::tolower);
+            if (density_table != "none") {
+                // Construct InjectorDensity with InjectorDensityTable,
+                // which tabulates the parser once at initialization.
+                h_inj_rho.reset(new InjectorDensity((InjectorDensityTable*)nullptr,
+                    *density_parser, species_name, source_name));
+            } else {
+                h_inj_rho.reset(new InjectorDensity((InjectorDensityParser*)nullptr,
+                    density_parser->compile<3>()));
+            }
         } else {
             StringParseAbortMessage("Density profile type", rho_prof_s);
         }
@@ -79,6 +79,7 @@ const std::map<std::string, int> current_deposition_algo_to_int = {
 
 const std::map<std::string, int> charge_deposition_algo_to_int = {
     {"standard",   ChargeDepositionAlgo::Standard },
+    {"sorted",     ChargeDepositionAlgo::Sorted },
     {"default",    ChargeDepositionAlgo::Standard }
 };
 
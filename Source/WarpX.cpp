@@ -31,6 +31,7 @@
 #include "FieldSolver/WarpX_FDTD.H"
 #include "Filter/NCIGodfreyFilter.H"
 #include "Initialization/ExternalField.H"
+#include "Initialization/ExternalFieldReader.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Fluids/MultiFluidContainer.H"
 #include "Fluids/WarpXFluidContainer.H"
@@ -124,6 +125,7 @@ short WarpX::load_balance_costs_update_algo;
 bool WarpX::do_dive_cleaning = false;
 bool WarpX::do_divb_cleaning = false;
 int WarpX::em_solver_medium;
+bool WarpX::do_fdtd_temporal_blocking = false;
 int WarpX::macroscopic_solver_algo;
 bool WarpX::do_single_precision_comms = false;
 
@@ -188,6 +190,7 @@ bool WarpX::sort_particles_for_deposition = false;
 amrex::IntVect WarpX::sort_idx_type(AMREX_D_DECL(0,0,0));
 
 bool WarpX::do_dynamic_scheduling = true;
+long WarpX::particle_chunk_size = 0;
 
 int WarpX::electrostatic_solver_id;
 int WarpX::poisson_solver_id;
@@ -195,6 +198,8 @@ Real WarpX::self_fields_required_precision = 1.e-11_rt;
 Real WarpX::self_fields_absolute_tolerance = 0.0_rt;
 int WarpX::self_fields_max_iters = 200;
 int WarpX::self_fields_verbosity = 2;
+bool WarpX::self_fields_reuse_solver = false;
+int WarpX::self_fields_beta_bins = 0;
 
 bool WarpX::do_subcycling = false;
 bool WarpX::do_multi_J = false;
@@ -208,6 +213,7 @@ IntVect WarpX::filter_npass_each_dir(1);
 
 int WarpX::n_field_gather_buffer = -1;
 int WarpX::n_current_deposition_buffer = -1;
+bool WarpX::incremental_buffer_partition = false;
 
 ablastr::utils::enums::GridType WarpX::grid_type;
 amrex::IntVect m_rho_nodal_flag;
@@ -260,6 +266,9 @@ WarpX::WarpX ()
 
     InitEB();
 
+    m_int_scratch_pool.Define();
+    m_long_scratch_pool.Define();
+
     ablastr::utils::SignalHandling::InitSignalHandling();
 
     // Geometry on all levels has been defined already.
@@ -755,8 +764,14 @@ WarpX::ReadParameters ()
             utils::parser::queryWithParser(
                 pp_warpx, "self_fields_max_iters", self_fields_max_iters);
             pp_warpx.query("self_fields_verbosity", self_fields_verbosity);
+            pp_warpx.query("self_fields_reuse_solver", self_fields_reuse_solver);
         }
 
+        utils::parser::queryWithParser(
+            pp_warpx, "self_fields_beta_bins", self_fields_beta_bins);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(self_fields_beta_bins >= 0,
+            "warpx.self_fields_beta_bins must be non-negative");
+
         poisson_solver_id = GetAlgorithmInteger(pp_warpx, "poisson_solver");
 #ifndef WARPX_DIM_3D
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
@@ -909,6 +924,7 @@ WarpX::ReadParameters ()
             pp_warpx, "n_field_gather_buffer", n_field_gather_buffer);
         utils::parser::queryWithParser(
             pp_warpx, "n_current_deposition_buffer", n_current_deposition_buffer);
+        pp_warpx.query("incremental_buffer_partition", incremental_buffer_partition);
 
         //Default value for the quantum parameter used in Maxwell’s QED equations
         m_quantum_xi_c2 = PhysConst::xi_c2;
@@ -1073,6 +1089,9 @@ WarpX::ReadParameters ()
         }
 
         pp_warpx.query("do_dynamic_scheduling", do_dynamic_scheduling);
+        utils::parser::queryWithParser(pp_warpx, "particle_chunk_size", particle_chunk_size);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(particle_chunk_size >= 0,
+            "warpx.particle_chunk_size must be >= 0");
 
         // Integer that corresponds to the type of grid used in the simulation
         // (collocated, staggered, hybrid)
@@ -1205,6 +1224,13 @@ WarpX::ReadParameters ()
         //       because its default depends on the solver selection
         current_deposition_algo = static_cast<short>(GetAlgorithmInteger(pp_algo, "current_deposition"));
         charge_deposition_algo = static_cast<short>(GetAlgorithmInteger(pp_algo, "charge_deposition"));
+        if (charge_deposition_algo == ChargeDepositionAlgo::Sorted) {
+#ifdef AMREX_USE_GPU
+            WARPX_ABORT_WITH_MESSAGE("algo.charge_deposition = sorted is only available on CPU");
+#endif
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_shared_mem_charge_deposition,
+                "algo.charge_deposition = sorted cannot be used with warpx.do_shared_mem_charge_deposition");
+        }
         particle_pusher_algo = static_cast<short>(GetAlgorithmInteger(pp_algo, "particle_pusher"));
         evolve_scheme = static_cast<short>(GetAlgorithmInteger(pp_algo, "evolve_scheme"));
 
@@ -1329,6 +1355,31 @@ WarpX::ReadParameters ()
             macroscopic_solver_algo = GetAlgorithmInteger(pp_algo,"macroscopic_sigma_method");
         }
 
+        pp_algo.query("fdtd_temporal_blocking", do_fdtd_temporal_blocking);
+        if (do_fdtd_temporal_blocking) {
+#if defined(WARPX_DIM_RZ) || defined(AMREX_USE_GPU) || defined(AMREX_USE_EB)
+            WARPX_ABORT_WITH_MESSAGE(
+                "algo.fdtd_temporal_blocking is only implemented on CPU, in Cartesian geometry and without embedded boundaries");
+#endif
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                evolve_scheme == EvolveScheme::Explicit &&
+                (electromagnetic_solver_id == ElectromagneticSolverAlgo::Yee ||
+                 electromagnetic_solver_id == ElectromagneticSolverAlgo::CKC) &&
+                em_solver_medium == MediumForEM::Vacuum,
+                "algo.fdtd_temporal_blocking requires the explicit evolve scheme and the Yee or CKC solver in vacuum");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                maxLevel() == 0 && !do_dive_cleaning && !do_divb_cleaning,
+                "algo.fdtd_temporal_blocking is not implemented with mesh refinement or divergence cleaning");
+            // The fields are recomputed in the guard cells outside of the domain,
+            // which is only correct with periodic boundaries
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                    field_boundary_lo[idim] == FieldBoundaryType::Periodic &&
+                    field_boundary_hi[idim] == FieldBoundaryType::Periodic,
+                    "algo.fdtd_temporal_blocking requires periodic field boundaries in all directions");
+            }
+        }
+
         if (evolve_scheme == EvolveScheme::SemiImplicitEM ||
             evolve_scheme == EvolveScheme::ThetaImplicitEM) {
 
@@ -1359,8 +1410,15 @@ WarpX::ReadParameters ()
         load_balance_intervals = utils::parser::IntervalsParser(
             load_balance_intervals_string_vec);
         pp_algo.query("load_balance_with_sfc", load_balance_with_sfc);
+        pp_algo.query("load_balance_hierarchical", load_balance_hierarchical);
+        if (load_balance_hierarchical) {
+            utils::parser::queryWithParser(
+                pp_algo, "load_balance_ranks_per_node", load_balance_ranks_per_node);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(load_balance_ranks_per_node >= 0,
+                "algo.load_balance_ranks_per_node must be >= 0");
+        }
         // Knapsack factor only used with non-SFC strategy
-        if (!load_balance_with_sfc) {
+        if (!load_balance_with_sfc && !load_balance_hierarchical) {
             pp_algo.query("load_balance_knapsack_factor", load_balance_knapsack_factor);
         }
         utils::parser::queryWithParser(pp_algo, "load_balance_efficiency_ratio_threshold",
@@ -2160,6 +2218,7 @@ WarpX::AllocLevelData (int lev, const BoxArray& ba, const DistributionMapping& d
         nox_fft, noy_fft, noz_fft,
         NCIGodfreyFilter::m_stencil_width,
         electromagnetic_solver_id,
+        WarpX::do_fdtd_temporal_blocking,
         maxLevel(),
         WarpX::m_v_galilean,
         WarpX::m_v_comoving,
@@ -0,0 +1,111 @@
+#! /usr/bin/env python3
+
+"""
+ Copyright 2024
+
+ This file is part of WarpX.
+
+ License: BSD-3-Clause-LBNL
+ """
+
+import argparse
+import json
+import sys
+
+"""
+Compare the results of run_benchmarks.py to a stored baseline, and flag the
+performance regressions.
+
+A metric is flagged when it is worse than the baseline by more than the
+relative tolerance. Throughputs (*_per_s) regress when they decrease, and
+times (communication time, region times) regress when they increase. The
+script exits with a non-zero code if a regression is found, so that it can be
+used in a CI job. Baselines are machine-specific: they should be generated with
+run_benchmarks.py on the machine (and with the launcher) used for the comparison.
+
+Example:
+    $ ./compare_benchmarks.py --baseline baseline.json --results results.json
+"""
+
+
+def is_higher_better(metric_name):
+    return metric_name.endswith("_per_s")
+
+
+def relative_change(baseline, value, higher_is_better):
+    """Relative degradation of value with respect to baseline (positive if worse)"""
+    if higher_is_better:
+        return (baseline - value) / baseline
+    return (value - baseline) / baseline
+
+
+def compare(baseline, results, tolerance, compare_regions, min_region_time):
+    """Return the list of regressions, as (deck, metric, baseline, value, change)"""
+    regressions = []
+    for deck, deck_baseline in baseline["decks"].items():
+        if deck not in results["decks"]:
+            print(f"Warning: {deck} is in the baseline but not in the results")
+            continue
+        deck_results = results["decks"][deck]
+        if deck_results["steps"] != deck_baseline["steps"]:
+            print(f"Warning: {deck} was run for {deck_results['steps']} steps, "
+                  f"and for {deck_baseline['steps']} steps in the baseline")
+
+        for metric, ref in deck_baseline["metrics"].items():
+            value = deck_results["metrics"].get(metric)
+            if ref is None or value is None or ref == 0.:
+                continue
+            change = relative_change(ref, value, is_higher_better(metric))
+            print(f"  {deck:24s} {metric:32s} {ref:12.4e} {value:12.4e} {-change:+8.1%}")
+            if change > tolerance:
+                regressions.append((deck, metric, ref, value, change))
+
+        if not compare_regions:
+            continue
+        for region, ref_entry in deck_baseline["regions"].items():
+            ref = ref_entry.get("incl_max", 0.)
+            if ref < min_region_time or region not in deck_results["regions"]:
+                continue
+            value = deck_results["regions"][region].get("incl_max", 0.)
+            change = relative_change(ref, value, higher_is_better=False)
+            if change > tolerance:
+                regressions.append((deck, region, ref, value, change))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Flag performance regressions of WarpX against a stored baseline")
+    parser.add_argument("--baseline", required=True,
+                        help="JSON file written by run_benchmarks.py on the reference version")
+    parser.add_argument("--results", required=True,
+                        help="JSON file written by run_benchmarks.py on the tested version")
+    parser.add_argument("--tolerance", type=float, default=0.1,
+                        help="relative degradation above which a metric is flagged (default: 0.1)")
+    parser.add_argument("--regions", action="store_true",
+                        help="also compare the inclusive time of each profiler region")
+    parser.add_argument("--min-region-time", dest="min_region_time", type=float, default=0.05,
+                        help="regions faster than this (in s) in the baseline are not compared")
+    args = parser.parse_args()
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+    with open(args.results) as f:
+        results = json.load(f)
+
+    print(f"  {'deck':24s} {'metric':32s} {'baseline':>12s} {'results':>12s} {'change':>8s}")
+    regressions = compare(baseline, results, args.tolerance, args.regions, args.min_region_time)
+
+    if not regressions:
+        print("No performance regression found.")
+        return
+
+    print(f"\n{len(regressions)} performance regression(s) found "
+          f"(tolerance: {args.tolerance:.0%}):")
+    for deck, metric, ref, value, change in regressions:
+        print(f"  {deck}: {metric} went from {ref:.4e} to {value:.4e} ({change:.1%} worse)")
+    sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,301 @@
+#! /usr/bin/env python3
+
+"""
+ Copyright 2024
+
+ This file is part of WarpX.
+
+ License: BSD-3-Clause-LBNL
+ """
+
+import argparse
+import datetime
+import json
+import os
+import platform
+import re
+import shutil
+import subprocess
+import sys
+
+"""
+Performance benchmarks of WarpX, run on a few representative decks of
+Examples/Physics_applications.
+
+Each deck is run for a small number of steps with the AMReX TinyProfiler
+(enabled by default in WarpX builds). The timers of the WARPX_PROFILE regions
+are parsed from the standard output and combined with the number of cells and
+macroparticles of the run, to compute per-kernel throughputs. The results are
+written to a JSON file, which can be compared to a stored baseline with
+compare_benchmarks.py.
+
+Example:
+    $ ./run_benchmarks.py --executable-2d <path/to/warpx.2d> \
+                          --executable-3d <path/to/warpx.3d> \
+                          --warpx-data <path/to/warpx-data> \
+                          --output results.json
+"""
+
+# Name of the reduced diagnostic added to each run to count the macroparticles
+particle_number_diag = "benchmark_particle_number"
+
+# Name of the full diagnostic added to each run to measure the I/O throughput
+io_diag = "benchmark_io"
+
+# Representative decks: name, input file (relative to the WarpX repository),
+# dimensionality and parameters overwritten on the command line.
+# The number of steps and the diagnostics are set by the runner.
+decks = {
+    "uniform_plasma": {
+        "inputs": "Examples/Physics_applications/uniform_plasma/inputs_3d",
+        "dim": 3,
+        "overrides": [],
+    },
+    "laser_acceleration": {
+        "inputs": "Examples/Physics_applications/laser_acceleration/inputs_3d",
+        "dim": 3,
+        "overrides": [],
+    },
+    "plasma_acceleration": {
+        "inputs": "Examples/Physics_applications/plasma_acceleration/inputs_3d_boost",
+        "dim": 3,
+        "overrides": [],
+    },
+    "capacitive_discharge": {
+        "inputs": "Examples/Physics_applications/capacitive_discharge/inputs_2d",
+        "dim": 2,
+        "overrides": [
+            "coll_ion.elastic_cross_section={warpx_data}/MCC_cross_sections/He/ion_scattering.dat",
+            "coll_ion.back_cross_section={warpx_data}/MCC_cross_sections/He/ion_back_scatter.dat",
+            "coll_elec.elastic_cross_section={warpx_data}/MCC_cross_sections/He/electron_scattering.dat",
+            "coll_elec.excitation1_cross_section={warpx_data}/MCC_cross_sections/He/excitation_1.dat",
+            "coll_elec.excitation2_cross_section={warpx_data}/MCC_cross_sections/He/excitation_2.dat",
+            "coll_elec.ionization_cross_section={warpx_data}/MCC_cross_sections/He/ionization.dat",
+        ],
+    },
+    "beam-beam_collision": {
+        "inputs": "Examples/Physics_applications/beam-beam_collision/inputs",
+        "dim": 3,
+        "overrides": [],
+    },
+}
+
+# TinyProfiler regions used for the per-kernel throughputs.
+# The time of a kernel is the sum of the maximum (over MPI ranks) inclusive
+# time of its regions.
+push_regions = ["PhysicalParticleContainer::Evolve::GatherAndPush",
+                "MultiParticleContainer::EvolveFused::GatherAndPush"]
+deposit_regions = ["WarpXParticleContainer::DepositCurrent::CurrentDeposition",
+                   "WarpXParticleContainer::DepositCharge::ChargeDeposition"]
+field_regions = ["WarpX::EvolveE()", "WarpX::EvolveB()", "WarpX::EvolveF()",
+                 "WarpX::EvolveG()", "WarpX::MacroscopicEvolveE()", "computePhi"]
+# Exclusive time of the AMReX communication regions
+comm_regions_regex = re.compile(
+    r"FillBoundary|ParallelCopy|SumBoundary|Redistribute|ParallelDescriptor::")
+io_regions_regex = re.compile(r"^FlushFormat\w+::WriteToFile\(\)$")
+
+regex_profiler_row = re.compile(
+    r"^(\S.*?)\s+(\d+)\s+([-+\d.eE]+)\s+([-+\d.eE]+)\s+([-+\d.eE]+)\s+([-+\d.eE]+)%\s*$")
+regex_profiler_header = re.compile(r"^Name\s+NCalls\s+(Excl|Incl)\.")
+regex_level_cells = re.compile(r"Level (\d+)\s+(\d+) grids\s+(\d+) cells")
+regex_total_time = re.compile(r"^Total Time\s*:\s*([-+\d.eE]+)", re.MULTILINE)
+
+
+def parse_tiny_profiler(text):
+    """Timers of the whole run, from the first Excl. and Incl. tables of
+    the TinyProfiler.
+
+    Returns a dictionary: region name -> {ncalls, excl_max, incl_max} (times in s)
+    """
+    regions = {}
+    seen = set()
+    kind = None
+    for line in text.splitlines():
+        header = regex_profiler_header.match(line)
+        if header:
+            kind = header.group(1).lower()
+            if kind in seen:
+                # The next tables are the ones of the sub-regions (e.g. Evolve)
+                break
+            seen.add(kind)
+            continue
+        if kind is None:
+            continue
+        row = regex_profiler_row.match(line)
+        if row is None:
+            continue
+        name = row.group(1).strip()
+        entry = regions.setdefault(name, {"ncalls": int(row.group(2))})
+        entry[kind + "_max"] = float(row.group(5))
+    return regions
+
+
+def parse_number_of_cells(text):
+    """Total number of cells over all levels, from the grid summary"""
+    cells = {}
+    for match in regex_level_cells.finditer(text):
+        cells[int(match.group(1))] = int(match.group(3))
+    return sum(cells.values())
+
+
+def parse_number_of_particles(run_dir):
+    """Average total number of macroparticles over the steps of the run"""
+    file_name = os.path.join(run_dir, "diags", "reducedfiles", particle_number_diag + ".txt")
+    if not os.path.isfile(file_name):
+        return 0.
+    values = []
+    with open(file_name) as f:
+        for line in f:
+            if line.startswith("#") or not line.strip():
+                continue
+            # Columns: step, time, total number of macroparticles, ...
+            values.append(float(line.split()[2]))
+    return sum(values) / len(values) if values else 0.
+
+
+def directory_size(path):
+    """Total size in bytes of the files in a directory"""
+    size = 0
+    for root, _, files in os.walk(path):
+        for file_name in files:
+            size += os.path.getsize(os.path.join(root, file_name))
+    return size
+
+
+def sum_regions(regions, names, column="incl_max"):
+    return sum(regions[name].get(column, 0.) for name in names if name in regions)
+
+
+def throughput(amount, seconds):
+    return amount / seconds if seconds > 0. else None
+
+
+def compute_metrics(regions, ncells, nparticles, nsteps, io_bytes):
+    """Per-kernel throughputs of one run"""
+    push_time = sum_regions(regions, push_regions)
+    deposit_time = sum_regions(regions, deposit_regions)
+    field_time = sum_regions(regions, field_regions)
+    comm_time = sum(entry.get("excl_max", 0.) for name, entry in regions.items()
+                    if comm_regions_regex.search(name))
+    io_time = sum(entry.get("incl_max", 0.) for name, entry in regions.items()
+                  if io_regions_regex.match(name))
+    return {
+        "particles_pushed_per_s": throughput(nparticles*nsteps, push_time),
+        "particles_deposited_per_s": throughput(nparticles*nsteps, deposit_time),
+        "cells_updated_per_s": throughput(ncells*nsteps, field_time),
+        "communication_s_per_step": comm_time / nsteps if nsteps > 0 else None,
+        "io_GB_per_s": throughput(io_bytes*1.e-9, io_time),
+    }
+
+
+def run_deck(name, deck, executable, args):
+    """Run one deck, and return its results"""
+    run_dir = os.path.join(args.work_dir, name)
+    if os.path.isdir(run_dir):
+        shutil.rmtree(run_dir)
+    os.makedirs(run_dir)
+
+    inputs = os.path.join(args.warpx_repo, deck["inputs"])
+    overrides = [o.format(warpx_data=os.path.abspath(args.warpx_data))
+                 for o in deck["overrides"]]
+    overrides += [
+        f"max_step={args.steps}",
+        "warpx.verbose=1",
+        f"warpx.reduced_diags_names={particle_number_diag}",
+        f"{particle_number_diag}.type=ParticleNumber",
+        f"{particle_number_diag}.intervals=1",
+        f"diagnostics.diags_names={io_diag}",
+        f"{io_diag}.diag_type=Full",
+        f"{io_diag}.intervals={args.steps}",
+        f"{io_diag}.format=plotfile",
+    ]
+    command = args.launcher.split() + [executable, os.path.abspath(inputs)] + overrides
+
+    print(f"Running {name} ...", flush=True)
+    with open(os.path.join(run_dir, "output.txt"), "w") as f:
+        process = subprocess.run(command, cwd=run_dir, stdout=subprocess.PIPE,
+                                 stderr=subprocess.STDOUT, text=True)
+        f.write(process.stdout)
+    if process.returncode != 0:
+        print(f"  {name} failed with return code {process.returncode}, "
+              f"see {os.path.join(run_dir, 'output.txt')}")
+        return None
+
+    text = process.stdout
+    regions = parse_tiny_profiler(text)
+    if not regions:
+        print(f"  No TinyProfiler output found for {name}: "
+              "was WarpX compiled with AMReX_TINY_PROFILE=ON?")
+        return None
+
+    ncells = parse_number_of_cells(text)
+    nparticles = parse_number_of_particles(run_dir)
+    io_bytes = directory_size(os.path.join(run_dir, "diags", io_diag))
+    total_time = regex_total_time.search(text)
+
+    return {
+        "inputs": deck["inputs"],
+        "steps": args.steps,
+        "cells": ncells,
+        "macroparticles": nparticles,
+        "total_time_s": float(total_time.group(1)) if total_time else None,
+        "metrics": compute_metrics(regions, ncells, nparticles, args.steps, io_bytes),
+        "regions": regions,
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Run the WarpX performance benchmarks and write per-kernel throughputs to JSON")
+    parser.add_argument("--executable-2d", dest="executable_2d", default=None,
+                        help="WarpX executable compiled for 2D")
+    parser.add_argument("--executable-3d", dest="executable_3d", default=None,
+                        help="WarpX executable compiled for 3D")
+    parser.add_argument("--warpx-repo", dest="warpx_repo",
+                        default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", ".."),
+                        help="path to the WarpX repository (default: this repository)")
+    parser.add_argument("--warpx-data", dest="warpx_data", default="warpx-data",
+                        help="path to the warpx-data repository (MCC cross sections)")
+    parser.add_argument("--work-dir", dest="work_dir", default="benchmark_runs",
+                        help="directory in which the decks are run")
+    parser.add_argument("--decks", nargs="+", default=list(decks.keys()),
+                        choices=list(decks.keys()), help="decks to run (default: all)")
+    parser.add_argument("--steps", type=int, default=20,
+                        help="number of steps of each run")
+    parser.add_argument("--launcher", default="",
+                        help='command used to launch WarpX, e.g. "mpiexec -n 4"')
+    parser.add_argument("--output", default="benchmark_results.json",
+                        help="JSON file in which the results are written")
+    args = parser.parse_args()
+
+    executables = {2: args.executable_2d, 3: args.executable_3d}
+
+    results = {
+        "date": datetime.datetime.now().isoformat(),
+        "machine": platform.node(),
+        "launcher": args.launcher,
+        "decks": {},
+    }
+    failed = False
+    for name in args.decks:
+        deck = decks[name]
+        executable = executables[deck["dim"]]
+        if executable is None:
+            print(f"Skipping {name}: no {deck['dim']}D executable given")
+            continue
+        deck_results = run_deck(name, deck, os.path.abspath(executable), args)
+        if deck_results is None:
+            failed = True
+            continue
+        results["decks"][name] = deck_results
+
+    with open(args.output, "w") as f:
+        json.dump(results, f, indent=2, sort_keys=True)
+    print(f"Results written to {args.output}")
+
+    if failed:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()